@@ -137,6 +137,38 @@ inline bytes toCompactBigEndian(byte _val, unsigned _min = 0)
 	return (_min || _val) ? bytes{ _val } : bytes{};
 }
 
+/// Appends the unsigned LEB128 encoding ("varint") of @a _val to @a o_out: seven bits per byte,
+/// least significant group first, the highest bit is set on all bytes but the last.
+template <class T>
+inline void appendVarint(T _val, bytes& o_out)
+{
+	static_assert(!std::numeric_limits<T>::is_signed, "only unsigned types supported");
+	do
+	{
+		byte b = byte(_val & 0x7f);
+		_val >>= 7;
+		o_out.push_back(_val ? (b | 0x80) : b);
+	}
+	while (_val);
+}
+
+/// Decodes an unsigned LEB128 encoded value starting at @a io_pos in @a _data and advances
+/// @a io_pos to the first byte after it. Reads at most until the end of @a _data.
+template <class T>
+inline T readVarint(bytesConstRef _data, size_t& io_pos)
+{
+	T ret = 0;
+	for (unsigned shift = 0; io_pos < _data.size(); shift += 7)
+	{
+		byte b = _data[io_pos++];
+		if (shift < unsigned(std::numeric_limits<T>::digits))
+			ret |= T(b & 0x7f) << shift;
+		if (!(b & 0x80))
+			break;
+	}
+	return ret;
+}
+
 /// Convenience function for conversion of a u256 to hex
 inline std::string toHex(u256 val, HexPrefix prefix = HexPrefix::DontAdd)
 {
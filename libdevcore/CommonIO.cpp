@@ -28,6 +28,10 @@
 #include <windows.h>
 #else
 #include <termios.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 #include <boost/filesystem.hpp>
 #include "Exceptions.h"
@@ -61,6 +65,50 @@ string dev::contentsString(string const& _file)
 	return contentsGeneric<string>(_file);
 }
 
+MappedFile::MappedFile(string const& _file)
+{
+#if defined(_WIN32)
+	if (!boost::filesystem::is_regular_file(_file))
+		BOOST_THROW_EXCEPTION(FileError() << errinfo_comment("Could not read file: " + _file));
+	m_contents = contentsString(_file);
+	m_data = m_contents.data();
+	m_size = m_contents.size();
+#else
+	int fd = open(_file.c_str(), O_RDONLY);
+	struct stat info;
+	if (fd < 0 || fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+	{
+		if (fd >= 0)
+			close(fd);
+		BOOST_THROW_EXCEPTION(FileError() << errinfo_comment("Could not read file: " + _file));
+	}
+	m_size = size_t(info.st_size);
+	if (m_size > 0)
+	{
+		void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED)
+		{
+			// Fall back to reading the file, e.g. for special file systems.
+			m_contents = contentsString(_file);
+			m_size = m_contents.size();
+		}
+		else
+			m_data = static_cast<char const*>(mapping);
+	}
+	close(fd);
+	if (!m_data)
+		m_data = m_contents.data();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+	if (m_size > 0 && m_data != m_contents.data())
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
 void dev::writeFile(std::string const& _file, bytesConstRef _data, bool _writeDeleteRename)
 {
 	namespace fs = boost::filesystem;
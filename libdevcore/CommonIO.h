@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <string>
+#include <boost/noncopyable.hpp>
 #include "Common.h"
 
 namespace dev
@@ -34,6 +35,25 @@ namespace dev
 /// If the file doesn't exist or isn't readable, returns an empty container / bytes.
 std::string contentsString(std::string const& _file);
 
+/// Read-only view of the contents of a file that is memory-mapped where this is supported
+/// and read into memory otherwise.
+class MappedFile: private boost::noncopyable
+{
+public:
+	/// Maps the file @a _file. Throws FileError if it cannot be read.
+	explicit MappedFile(std::string const& _file);
+	~MappedFile();
+
+	char const* data() const { return m_data; }
+	size_t size() const { return m_size; }
+
+private:
+	char const* m_data = nullptr;
+	size_t m_size = 0;
+	/// Contents of the file if it is not mapped.
+	std::string m_contents;
+};
+
 /// Write the given binary data into the given file, replacing the file if it pre-exists.
 /// Throws exception on error.
 /// @param _writeDeleteRename useful not to lose any data: If set, first writes to another file in
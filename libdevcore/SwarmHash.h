@@ -27,6 +27,7 @@ namespace dev
 {
 
 /// Compute the "swarm hash" of @a _data
-h256 swarmHash(std::string const& _data);
+h256 swarmHash(bytesConstRef _data);
+inline h256 swarmHash(std::string const& _data) { return swarmHash(bytesConstRef(_data)); }
 
 }
@@ -94,6 +94,32 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 	}
 }
 
+bool Assembly::isSubReferenced(size_t _subId) const
+{
+	for (AssemblyItem const& i: m_items)
+		if (i.type() == PushSub && i.data() == _subId)
+			return true;
+	return false;
+}
+
+set<h256> Assembly::dataStoredInSubs() const
+{
+	set<h256> ret;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		if (!isSubReferenced(subId))
+			continue;
+		Assembly const& sub = *m_subs[subId];
+		// Data of a sub is only part of its bytecode if it is referenced there.
+		for (AssemblyItem const& i: sub.m_items)
+			if (i.type() == PushData && sub.m_data.count(h256(i.data())))
+				ret.insert(h256(i.data()));
+		set<h256> subData = sub.dataStoredInSubs();
+		ret.insert(subData.begin(), subData.end());
+	}
+	return ret;
+}
+
 namespace
 {
 
@@ -238,95 +264,428 @@ string toStringInHex(u256 _value)
 	return hexStr.str();
 }
 
-Json::Value Assembly::streamAsmJson(ostream& _out, StringMap const& _sourceCodes) const
+namespace
 {
-	Json::Value root;
 
-	Json::Value collection(Json::arrayValue);
+/// Runs the common subexpression eliminator on the items from @a _iter up to and including the
+/// next item that ends the block and advances @a _iter past them.
+/// @param io_state the knowledge at the start of the items, replaced by the knowledge after them
+/// @returns the optimised items or the original items if the optimised ones are not fewer.
+AssemblyItems eliminateCommonSubexpressions(
+	AssemblyItems::const_iterator& _iter,
+	AssemblyItems::const_iterator _end,
+	KnownState& io_state,
+	bool _breakAtLogs
+)
+{
+	CommonSubexpressionEliminator eliminator(io_state);
+	auto orig = _iter;
+	_iter = eliminator.feedItems(_iter, _end, _breakAtLogs);
+	AssemblyItems optimisedChunk;
+	bool shouldReplace = false;
+	try
+	{
+		optimisedChunk = eliminator.getOptimizedItems();
+		shouldReplace = (optimisedChunk.size() < size_t(_iter - orig));
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	io_state = eliminator.finalState();
+	return shouldReplace ? optimisedChunk : AssemblyItems(orig, _iter);
+}
+
+/// Streams the same JSON object as Assembly::createJsonValue, keys in the same (sorted) order,
+/// indented like the default Json::Value stream operator.
+void streamJsonValue(ostream& _out, string const& _indent, string const& _name, int _begin, int _end, string const& _value, string const& _jumpType)
+{
+	string const memberIndent = "\n" + _indent + "\t";
+	_out << "\n" << _indent << "{";
+	_out << memberIndent << "\"begin\" : " << _begin << "," << memberIndent << "\"end\" : " << _end;
+	if (!_jumpType.empty())
+		_out << "," << memberIndent << "\"jumpType\" : " << Json::valueToQuotedString(_jumpType.c_str());
+	_out << "," << memberIndent << "\"name\" : " << Json::valueToQuotedString(_name.c_str());
+	if (!_value.empty())
+		_out << "," << memberIndent << "\"value\" : " << Json::valueToQuotedString(_value.c_str());
+	_out << "\n" << _indent << "}";
+}
+
+}
+
+void Assembly::forEachJsonItem(function<void(string const&, SourceLocation const&, string const&, string const&)> const& _visitor) const
+{
 	for (AssemblyItem const& i: m_items)
 	{
 		switch (i.type())
 		{
 		case Operation:
-			collection.append(
-				createJsonValue(instructionInfo(i.instruction()).name, i.location().start, i.location().end, i.getJumpTypeAsString()));
+			_visitor(instructionInfo(i.instruction()).name, i.location(), i.getJumpTypeAsString(), "");
 			break;
 		case Push:
-			collection.append(
-				createJsonValue("PUSH", i.location().start, i.location().end, toStringInHex(i.data()), i.getJumpTypeAsString()));
+			_visitor("PUSH", i.location(), toStringInHex(i.data()), i.getJumpTypeAsString());
 			break;
 		case PushString:
-			collection.append(
-				createJsonValue("PUSH tag", i.location().start, i.location().end, m_strings.at((h256)i.data())));
+			_visitor("PUSH tag", i.location(), m_strings.at((h256)i.data()), "");
 			break;
 		case PushTag:
 			if (i.data() == 0)
-				collection.append(
-					createJsonValue("PUSH [ErrorTag]", i.location().start, i.location().end, ""));
+				_visitor("PUSH [ErrorTag]", i.location(), "", "");
 			else
-				collection.append(
-					createJsonValue("PUSH [tag]", i.location().start, i.location().end, string(i.data())));
+				_visitor("PUSH [tag]", i.location(), i.data().str(), "");
 			break;
 		case PushSub:
-			collection.append(
-				createJsonValue("PUSH [$]", i.location().start, i.location().end, dev::toString(h256(i.data()))));
+			_visitor("PUSH [$]", i.location(), dev::toString(h256(i.data())), "");
 			break;
 		case PushSubSize:
-			collection.append(
-				createJsonValue("PUSH #[$]", i.location().start, i.location().end, dev::toString(h256(i.data()))));
+			_visitor("PUSH #[$]", i.location(), dev::toString(h256(i.data())), "");
 			break;
 		case PushProgramSize:
-			collection.append(
-				createJsonValue("PUSHSIZE", i.location().start, i.location().end));
+			_visitor("PUSHSIZE", i.location(), "", "");
 			break;
 		case PushLibraryAddress:
-			collection.append(
-				createJsonValue("PUSHLIB", i.location().start, i.location().end, m_libraries.at(h256(i.data())))
-			);
+			_visitor("PUSHLIB", i.location(), m_libraries.at(h256(i.data())), "");
 			break;
 		case Tag:
-			collection.append(
-				createJsonValue("tag", i.location().start, i.location().end, string(i.data())));
-			collection.append(
-				createJsonValue("JUMPDEST", i.location().start, i.location().end));
+			_visitor("tag", i.location(), i.data().str(), "");
+			_visitor("JUMPDEST", i.location(), "", "");
 			break;
 		case PushData:
-			collection.append(createJsonValue("PUSH data", i.location().start, i.location().end, toStringInHex(i.data())));
+			_visitor("PUSH data", i.location(), toStringInHex(i.data()), "");
 			break;
 		default:
 			BOOST_THROW_EXCEPTION(InvalidOpcode());
 		}
 	}
+}
+
+map<string, pair<string, Assembly const*>> Assembly::jsonDataEntries() const
+{
+	// Data and subs share one JSON object, whose keys are sorted.
+	map<string, pair<string, Assembly const*>> entries;
+	for (auto const& i: m_data)
+		if (u256(i.first) >= m_subs.size())
+			entries[toStringInHex((u256)i.first)] = make_pair(toHex(i.second), nullptr);
+	for (size_t i = 0; i < m_subs.size(); ++i)
+	{
+		std::stringstream hexStr;
+		hexStr << hex << i;
+		entries[hexStr.str()] = make_pair(string(), m_subs[i].get());
+	}
+	return entries;
+}
 
+Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
+{
+	Json::Value root;
+
+	Json::Value collection(Json::arrayValue);
+	forEachJsonItem([&](string const& _name, SourceLocation const& _location, string const& _value, string const& _jumpType)
+	{
+		collection.append(createJsonValue(_name, _location.start, _location.end, _value, _jumpType));
+	});
 	root[".code"] = collection;
 
 	if (!m_data.empty() || !m_subs.empty())
 	{
 		Json::Value data;
-		for (auto const& i: m_data)
-			if (u256(i.first) >= m_subs.size())
-				data[toStringInHex((u256)i.first)] = toHex(i.second);
+		for (auto const& entry: jsonDataEntries())
+			if (entry.second.second)
+				data[entry.first] = entry.second.second->assemblyJSON(_sourceCodes);
+			else
+				data[entry.first] = entry.second.first;
+		root[".data"] = data;
+	}
+	return root;
+}
 
-		for (size_t i = 0; i < m_subs.size(); ++i)
+void Assembly::streamAsmJson(ostream& _out, StringMap const& _sourceCodes, string const& _indent) const
+{
+	string const memberIndent = "\n" + _indent + "\t";
+	_out << "{" << memberIndent << "\".code\" : ";
+	bool first = true;
+	forEachJsonItem([&](string const& _name, SourceLocation const& _location, string const& _value, string const& _jumpType)
+	{
+		_out << (first ? memberIndent + "[" : ",");
+		first = false;
+		streamJsonValue(_out, _indent + "\t\t", _name, _location.start, _location.end, _value, _jumpType);
+	});
+	_out << (first ? "[]" : memberIndent + "]");
+
+	if (!m_data.empty() || !m_subs.empty())
+	{
+		_out << "," << memberIndent << "\".data\" : " << memberIndent << "{";
+		first = true;
+		for (auto const& entry: jsonDataEntries())
 		{
-			std::stringstream hexStr;
-			hexStr << hex << i;
-			data[hexStr.str()] = m_subs[i]->stream(_out, "", _sourceCodes, true);
+			if (!first)
+				_out << ",";
+			first = false;
+			_out << memberIndent << "\t" << Json::valueToQuotedString(entry.first.c_str()) << " : ";
+			if (entry.second.second)
+			{
+				_out << memberIndent << "\t";
+				entry.second.second->streamAsmJson(_out, _sourceCodes, _indent + "\t\t");
+			}
+			else
+				_out << Json::valueToQuotedString(entry.second.first.c_str());
 		}
-		root[".data"] = data;
-		_out << root;
+		_out << memberIndent << "}";
 	}
-	return root;
+	_out << "\n" << _indent << "}";
 }
 
-Json::Value Assembly::stream(ostream& _out, string const& _prefix, StringMap const& _sourceCodes, bool _inJsonFormat) const
+void Assembly::stream(ostream& _out, string const& _prefix, StringMap const& _sourceCodes, bool _inJsonFormat) const
 {
 	if (_inJsonFormat)
-		return streamAsmJson(_out, _sourceCodes);
-	else
 	{
+		streamAsmJson(_out, _sourceCodes);
+		_out << endl;
+	}
+	else
 		streamAsm(_out, _prefix, _sourceCodes);
-		return Json::Value();
+}
+
+/*
+ * Binary assembly format (all integers are unsigned LEB128 varints unless noted otherwise):
+ *
+ * assembly: "EVMA" version:byte body
+ * body:     usedTags itemCount item* dataCount (hash:32 bytes size data:bytes)*
+ *           size auxiliaryData:bytes subCount body*
+ * item:     type:byte jumpType:byte (begin + 1) (end + 1) payload
+ * payload:  Operation: instruction:byte
+ *           PushString, PushLibraryAddress: size string:bytes
+ *           PushProgramSize: nothing
+ *           all other types: size data:bytes (compact big endian)
+ *
+ * The type and jump type bytes are the codes listed below, which do not depend on the
+ * order of the enums.
+ */
+
+namespace
+{
+
+/// Code of each item type in the binary format.
+vector<pair<AssemblyItemType, byte>> const c_binaryItemTypes{
+	{Operation, 1},
+	{Push, 2},
+	{PushString, 3},
+	{PushTag, 4},
+	{PushSub, 5},
+	{PushSubSize, 6},
+	{PushProgramSize, 7},
+	{Tag, 8},
+	{PushData, 9},
+	{PushLibraryAddress, 10}
+};
+
+/// Code of each jump type in the binary format.
+vector<pair<AssemblyItem::JumpType, byte>> const c_binaryJumpTypes{
+	{AssemblyItem::JumpType::Ordinary, 0},
+	{AssemblyItem::JumpType::IntoFunction, 1},
+	{AssemblyItem::JumpType::OutOfFunction, 2}
+};
+
+/// Maximum nesting depth of sub-assemblies accepted by the reader.
+size_t const c_maxBinarySubDepth = 64;
+
+template <class T>
+byte binaryCode(vector<pair<T, byte>> const& _codes, T _value)
+{
+	for (auto const& code: _codes)
+		if (code.first == _value)
+			return code.second;
+	BOOST_THROW_EXCEPTION(AssemblyException() << errinfo_comment("Item not representable in the binary format."));
+}
+
+template <class T>
+T fromBinaryCode(vector<pair<T, byte>> const& _codes, byte _code)
+{
+	for (auto const& code: _codes)
+		if (code.second == _code)
+			return code.first;
+	BOOST_THROW_EXCEPTION(InvalidBinaryAssembly() << errinfo_comment("Unknown item code."));
+}
+
+}
+
+/// Reads the binary format written by Assembly::streamBinary.
+class Assembly::BinaryReader
+{
+public:
+	explicit BinaryReader(bytesConstRef _data): m_data(_data) {}
+
+	size_t readVarint()
+	{
+		if (m_pos >= m_data.size())
+			fail();
+		size_t start = m_pos;
+		size_t ret = dev::readVarint<size_t>(m_data, m_pos);
+		if ((m_data[m_pos - 1] & 0x80) || m_pos - start > 10)
+			fail();
+		return ret;
+	}
+	byte readByte()
+	{
+		if (m_pos >= m_data.size())
+			fail();
+		return m_data[m_pos++];
+	}
+	bytesConstRef readBytes(size_t _length)
+	{
+		if (_length > m_data.size() - m_pos)
+			fail();
+		bytesConstRef ret = m_data.cropped(m_pos, _length);
+		m_pos += _length;
+		return ret;
+	}
+	bytesConstRef readBlob() { return readBytes(readVarint()); }
+	bool atEnd() const { return m_pos == m_data.size(); }
+	[[noreturn]] void fail() const { BOOST_THROW_EXCEPTION(InvalidBinaryAssembly() << errinfo_comment("Malformed binary assembly.")); }
+
+private:
+	bytesConstRef m_data;
+	size_t m_pos = 0;
+};
+
+void Assembly::streamBinary(ostream& _out) const
+{
+	_out << "EVMA" << char(1);
+	streamBinaryBody(_out);
+}
+
+void Assembly::streamBinaryBody(ostream& _out) const
+{
+	auto write = [&](bytes const& _data) { _out.write(reinterpret_cast<char const*>(_data.data()), _data.size()); };
+	auto writeBlob = [&](bytes const& _data)
+	{
+		bytes size;
+		appendVarint(_data.size(), size);
+		write(size);
+		write(_data);
+	};
+
+	bytes header;
+	appendVarint(m_usedTags, header);
+	appendVarint(m_items.size(), header);
+	write(header);
+	for (AssemblyItem const& i: m_items)
+	{
+		bytes item{binaryCode(c_binaryItemTypes, i.type()), binaryCode(c_binaryJumpTypes, i.getJumpType())};
+		appendVarint(unsigned(i.location().start + 1), item);
+		appendVarint(unsigned(i.location().end + 1), item);
+		write(item);
+		switch (i.type())
+		{
+		case Operation:
+			write(bytes{byte(i.instruction())});
+			break;
+		case PushString:
+			writeBlob(asBytes(m_strings.at(h256(i.data()))));
+			break;
+		case PushLibraryAddress:
+			writeBlob(asBytes(m_libraries.at(h256(i.data()))));
+			break;
+		case PushProgramSize:
+			break;
+		default:
+			writeBlob(toCompactBigEndian(i.data()));
+		}
+	}
+
+	bytes dataHeader;
+	appendVarint(m_data.size(), dataHeader);
+	write(dataHeader);
+	for (auto const& data: m_data)
+	{
+		write(data.first.asBytes());
+		writeBlob(data.second);
+	}
+	writeBlob(m_auxiliaryData);
+
+	bytes subHeader;
+	appendVarint(m_subs.size(), subHeader);
+	write(subHeader);
+	for (auto const& sub: m_subs)
+		sub->streamBinaryBody(_out);
+}
+
+AssemblyPointer Assembly::fromBinary(bytesConstRef _data)
+{
+	if (_data.size() < 5 || _data.cropped(0, 5).toString() != string("EVMA") + char(1))
+		BOOST_THROW_EXCEPTION(InvalidBinaryAssembly() << errinfo_comment("Invalid header."));
+	BinaryReader reader(_data.cropped(5));
+	AssemblyPointer assembly = make_shared<Assembly>();
+	assembly->readBinaryBody(reader, 0);
+	if (!reader.atEnd())
+		reader.fail();
+	return assembly;
+}
+
+void Assembly::readBinaryBody(BinaryReader& _reader, size_t _depth)
+{
+	if (_depth > c_maxBinarySubDepth)
+		_reader.fail();
+	m_usedTags = unsigned(_reader.readVarint());
+	size_t itemCount = _reader.readVarint();
+	for (size_t i = 0; i < itemCount; ++i)
+	{
+		AssemblyItemType type = fromBinaryCode(c_binaryItemTypes, _reader.readByte());
+		AssemblyItem::JumpType jumpType = fromBinaryCode(c_binaryJumpTypes, _reader.readByte());
+		SourceLocation location;
+		location.start = int(_reader.readVarint()) - 1;
+		location.end = int(_reader.readVarint()) - 1;
+		AssemblyItem item(type);
+		switch (type)
+		{
+		case Operation:
+		{
+			Instruction instruction = Instruction(_reader.readByte());
+			if (!isValidInstruction(instruction))
+				_reader.fail();
+			item = AssemblyItem(instruction);
+			break;
+		}
+		case PushString:
+			item = newPushString(_reader.readBlob().toString());
+			break;
+		case PushLibraryAddress:
+			item = newPushLibraryAddress(_reader.readBlob().toString());
+			break;
+		case PushProgramSize:
+			break;
+		default:
+		{
+			bytesConstRef data = _reader.readBlob();
+			if (data.size() > 32)
+				_reader.fail();
+			item = AssemblyItem(type, fromBigEndian<u256>(data));
+		}
+		}
+		item.setJumpType(jumpType);
+		item.setLocation(location);
+		m_items.push_back(item);
+	}
+
+	size_t dataCount = _reader.readVarint();
+	for (size_t i = 0; i < dataCount; ++i)
+	{
+		h256 hash(_reader.readBytes(32));
+		m_data[hash] = _reader.readBlob().toBytes();
+	}
+	m_auxiliaryData = _reader.readBlob().toBytes();
+
+	size_t subCount = _reader.readVarint();
+	for (size_t i = 0; i < subCount; ++i)
+	{
+		m_subs.push_back(make_shared<Assembly>());
+		m_subs.back()->readBinaryBody(_reader, _depth + 1);
 	}
 }
 
@@ -351,17 +710,23 @@ void Assembly::injectStart(AssemblyItem const& _i)
 	m_items.insert(m_items.begin(), _i);
 }
 
-Assembly& Assembly::optimise(bool _enable, bool _isCreation, size_t _runs)
+Assembly& Assembly::optimise(bool _enable, bool _isCreation, size_t _runs, ComputeMethodCache* _constantCache)
 {
-	optimiseInternal(_enable, _isCreation, _runs);
+	if (_constantCache)
+		optimiseInternal(_enable, _isCreation, _runs, *_constantCache);
+	else
+	{
+		ComputeMethodCache constantCache;
+		optimiseInternal(_enable, _isCreation, _runs, constantCache);
+	}
 	return *this;
 }
 
-map<u256, u256> Assembly::optimiseInternal(bool _enable, bool _isCreation, size_t _runs)
+map<u256, u256> Assembly::optimiseInternal(bool _enable, bool _isCreation, size_t _runs, ComputeMethodCache& _constantCache)
 {
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(_enable, false, _runs);
+		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(_enable, false, _runs, _constantCache);
 		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
 	}
 
@@ -389,40 +754,58 @@ map<u256, u256> Assembly::optimiseInternal(bool _enable, bool _isCreation, size_
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			// Its data flow analysis is still used to provide the knowledge about storage and
+			// memory that is common to all paths leading to a tag (jumps to unknown targets reset
+			// that knowledge). Within the code between two tags, the knowledge is carried over
+			// from one block to the next, except after unconditional jumps.
+			map<BlockId, KnownStatePointer> tagStates = ControlFlowGraph(m_items).tagStates();
 			AssemblyItems optimisedItems;
 
-			auto iter = m_items.begin();
+			AssemblyItems::const_iterator iter = m_items.begin();
+			KnownStatePointer knownState;
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator(emptyState);
 				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end());
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
-				}
-				catch (StackTooDeepException const&)
+				KnownState state;
+				AssemblyItems optimisedChunk = eliminateCommonSubexpressions(iter, m_items.end(), state, false);
+				// Blocks can contain log instructions, which allows to combine storage accesses
+				// on both sides of a log. Since the logs have to be kept in place, this sometimes
+				// needs more stack shuffling than optimising the parts between the logs separately,
+				// so we use whatever is shorter.
+				if (any_of(orig, iter, [](AssemblyItem const& _item) { return SemanticInformation::isLogInstruction(_item); }))
 				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
+					AssemblyItems splitChunk;
+					KnownState splitState;
+					for (auto part = orig; part != iter;)
+						splitChunk += eliminateCommonSubexpressions(part, iter, splitState, true);
+					if (splitChunk.size() < optimisedChunk.size())
+						optimisedChunk = move(splitChunk);
 				}
-				catch (ItemNotAvailableException const&)
+				// The knowledge from previous blocks can replace loads by values that are already
+				// on the stack, but values that are not on the stack anymore cannot be used, so
+				// it is only used if that results in shorter code.
+				if (knownState)
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					auto knownIter = orig;
+					AssemblyItems knownChunk = eliminateCommonSubexpressions(knownIter, m_items.end(), *knownState, false);
+					if (knownChunk.size() < optimisedChunk.size())
+						optimisedChunk = move(knownChunk);
+					state = *knownState;
 				}
+				if (optimisedChunk.size() < size_t(iter - orig))
+					count++;
+				optimisedItems += optimisedChunk;
 
-				if (shouldReplace)
+				AssemblyItem const& lastItem = *(iter - 1);
+				if (lastItem.type() == Tag)
 				{
-					count++;
-					optimisedItems += optimisedChunk;
+					auto it = tagStates.find(BlockId(lastItem.data()));
+					knownState = it == tagStates.end() ? nullptr : it->second->copy();
 				}
+				else if (SemanticInformation::altersControlFlow(lastItem) && lastItem != AssemblyItem(Instruction::JUMPI))
+					knownState.reset();
 				else
-					copy(orig, iter, back_inserter(optimisedItems));
+					knownState = make_shared<KnownState>(move(state));
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
@@ -437,7 +820,8 @@ map<u256, u256> Assembly::optimiseInternal(bool _enable, bool _isCreation, size_
 			_isCreation,
 			_isCreation ? 1 : _runs,
 			*this,
-			m_items
+			m_items,
+			_constantCache
 		);
 
 	return tagReplacements;
@@ -460,6 +844,7 @@ LinkerObject const& Assembly::assemble() const
 
 	size_t bytesRequiredForCode = bytesRequired(subTagSize);
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, -1);
+	m_dataPositionsInBytecode.clear();
 	map<size_t, pair<size_t, size_t>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
@@ -474,9 +859,12 @@ LinkerObject const& Assembly::assemble() const
 	unsigned bytesPerDataRef = dev::bytesRequired(bytesRequiredIncludingData);
 	byte dataRefPush = (byte)Instruction::PUSH1 - 1 + bytesPerDataRef;
 	ret.bytecode.reserve(bytesRequiredIncludingData);
+	ret.itemOffsets.clear();
+	ret.itemOffsets.reserve(m_items.size());
 
 	for (AssemblyItem const& i: m_items)
 	{
+		ret.itemOffsets.push_back(ret.bytecode.size());
 		// store position of the invalid jump destination
 		if (i.type() != Tag && m_tagPositionsInBytecode[0] == size_t(-1))
 			m_tagPositionsInBytecode[0] = ret.bytecode.size();
@@ -574,7 +962,10 @@ LinkerObject const& Assembly::assemble() const
 			bytesRef r(ret.bytecode.data() + ref->second, bytesPerDataRef);
 			toBigEndian(ret.bytecode.size(), r);
 		}
+		size_t subStart = ret.bytecode.size();
 		ret.append(m_subs[i]->assemble());
+		for (auto const& dataPosition: m_subs[i]->m_dataPositionsInBytecode)
+			m_dataPositionsInBytecode.insert(make_pair(dataPosition.first, subStart + dataPosition.second));
 	}
 	for (auto const& i: tagRef)
 	{
@@ -603,8 +994,19 @@ LinkerObject const& Assembly::assemble() const
 			bytesRef r(ret.bytecode.data() + ref->second, bytesPerDataRef);
 			toBigEndian(ret.bytecode.size(), r);
 		}
+		m_dataPositionsInBytecode[dataItem.first] = ret.bytecode.size();
 		ret.bytecode += dataItem.second;
 	}
+	// References to data that is not stored here but shared with one of the subs.
+	for (auto const& ref: dataRef)
+	{
+		if (m_data.count(ref.first))
+			continue;
+		auto position = m_dataPositionsInBytecode.find(ref.first);
+		assertThrow(position != m_dataPositionsInBytecode.end(), AssemblyException, "Reference to non-existing data.");
+		bytesRef r(ret.bytecode.data() + ref.second, bytesPerDataRef);
+		toBigEndian(position->second, r);
+	}
 
 	ret.bytecode += m_auxiliaryData;
 
@@ -32,6 +32,7 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <set>
 
 namespace dev
 {
@@ -39,6 +40,7 @@ namespace eth
 {
 
 using AssemblyPointer = std::shared_ptr<Assembly>;
+class ComputeMethodCache;
 
 class Assembly
 {
@@ -99,32 +101,71 @@ public:
 	/// Assembles the assembly into bytecode. The assembly should not be modified after this call.
 	LinkerObject const& assemble() const;
 	bytes const& data(h256 const& _i) const { return m_data.at(_i); }
+	/// @returns the hashes of all data items that end up in the bytecode of the subs of this
+	/// assembly (recursively). Since the subs are appended to the bytecode, such data can be
+	/// referenced via PushData without storing it a second time.
+	std::set<h256> dataStoredInSubs() const;
 
 	/// Modify (if @a _enable is set) and return the current assembly such that creation and
 	/// execution gas usage is optimised. @a _isCreation should be true for the top-level assembly.
 	/// @a _runs specifes an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime.
 	/// If @a _enable is not set, will perform some simple peephole optimizations.
-	Assembly& optimise(bool _enable, bool _isCreation = true, size_t _runs = 200);
-	Json::Value stream(
+	/// @a _constantCache, if given, is used to share the representations found for constants
+	/// across several assemblies.
+	Assembly& optimise(
+		bool _enable,
+		bool _isCreation = true,
+		size_t _runs = 200,
+		ComputeMethodCache* _constantCache = nullptr
+	);
+	/// Streams the assembly to @a _out, either as text or, if @a _inJsonFormat is set, as JSON.
+	/// The JSON is written item by item, i.e. memory usage does not depend on the size of the
+	/// assembly, and is identical to streaming @a assemblyJSON with the default Json::Value
+	/// stream operator.
+	void stream(
 		std::ostream& _out,
 		std::string const& _prefix = "",
 		const StringMap &_sourceCodes = StringMap(),
 		bool _inJsonFormat = false
 	) const;
+	/// @returns the JSON representation of the assembly and its subs.
+	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const;
+	/// Streams a compact binary encoding of the assembly and its subs to @a _out.
+	/// The format is described in Assembly.cpp.
+	void streamBinary(std::ostream& _out) const;
+	/// @returns the assembly encoded in @a _data by @a streamBinary. Source names of the item
+	/// locations are not part of the format and thus not restored.
+	/// @throws InvalidBinaryAssembly if the data is malformed.
+	static AssemblyPointer fromBinary(bytesConstRef _data);
 
 protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags.
-	std::map<u256, u256> optimiseInternal(bool _enable, bool _isCreation, size_t _runs);
+	std::map<u256, u256> optimiseInternal(bool _enable, bool _isCreation, size_t _runs, ComputeMethodCache& _constantCache);
 
 	void donePath() { if (m_totalDeposit != INT_MAX && m_totalDeposit != m_deposit) BOOST_THROW_EXCEPTION(InvalidDeposit()); }
 	unsigned bytesRequired(unsigned subTagSize) const;
+	/// @returns true if the sub with index @a _subId is referenced and thus part of the bytecode.
+	bool isSubReferenced(size_t _subId) const;
 
 private:
-	Json::Value streamAsmJson(std::ostream& _out, StringMap const& _sourceCodes) const;
+	class BinaryReader;
+
+	/// Streams the JSON object of the assembly, whose lines after the first are indented by @a _indent.
+	void streamAsmJson(std::ostream& _out, StringMap const& _sourceCodes, std::string const& _indent = "") const;
 	std::ostream& streamAsm(std::ostream& _out, std::string const& _prefix, StringMap const& _sourceCodes) const;
+	void streamBinaryBody(std::ostream& _out) const;
+	/// Reads the body of a sub-assembly nested @a _depth levels deep into this (empty) assembly.
+	void readBinaryBody(BinaryReader& _reader, size_t _depth);
 	Json::Value createJsonValue(std::string _name, int _begin, int _end, std::string _value = std::string(), std::string _jumpType = std::string()) const;
+	/// Calls @a _visitor with the name, location, value and jump type of every JSON item.
+	void forEachJsonItem(
+		std::function<void(std::string const&, SourceLocation const&, std::string const&, std::string const&)> const& _visitor
+	) const;
+	/// @returns the keys of the ".data" JSON object, mapped to either the hex-encoded data
+	/// or the sub-assembly.
+	std::map<std::string, std::pair<std::string, Assembly const*>> jsonDataEntries() const;
 
 protected:
 	/// 0 is reserved for exception
@@ -139,6 +180,8 @@ protected:
 
 	mutable LinkerObject m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
+	/// Positions of the data items of this assembly and its subs in the assembled bytecode.
+	mutable std::map<h256, size_t> m_dataPositionsInBytecode;
 
 	int m_deposit = 0;
 	int m_baseDeposit = 0;
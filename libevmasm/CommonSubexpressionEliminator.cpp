@@ -157,6 +157,9 @@ AssemblyItems CSECodeGenerator::generateCode(
 		for (auto id: {p.first, p.second})
 			if (unsigned seqNr = m_expressionClasses.representative(id).sequenceNumber)
 			{
+				if (seqNr < _initialSequenceNumber && m_classPositions.count(id))
+					// Computed before this block and still on the stack.
+					continue;
 				if (seqNr < _initialSequenceNumber)
 					// Invalid sequenced operation.
 					// @todo quick fix for now. Proper fix needs to choose representative with higher
@@ -234,12 +237,13 @@ void CSECodeGenerator::addDependencies(Id _c)
 	if (expr.item && expr.item->type() == Operation && (
 		expr.item->instruction() == Instruction::SLOAD ||
 		expr.item->instruction() == Instruction::MLOAD ||
-		expr.item->instruction() == Instruction::SHA3
+		expr.item->instruction() == Instruction::SHA3 ||
+		SemanticInformation::isLogInstruction(*expr.item)
 	))
 	{
-		// this loads an unknown value from storage or memory and thus, in addition to its
-		// arguments, depends on all store operations to addresses where we do not know that
-		// they are different that occur before this load
+		// this loads an unknown value from storage or memory (or logs a memory area) and thus,
+		// in addition to its arguments, depends on all store operations to addresses where we
+		// do not know that they are different that occur before this load
 		StoreOperation::Target target = expr.item->instruction() == Instruction::SLOAD ?
 			StoreOperation::Storage : StoreOperation::Memory;
 		Id slotToLoadFrom = expr.arguments.at(0);
@@ -261,6 +265,11 @@ void CSECodeGenerator::addDependencies(Id _c)
 				knownToBeIndependent = m_expressionClasses.knownToBeDifferentBy32(slot, slotToLoadFrom);
 				break;
 			case Instruction::SHA3:
+			case Instruction::LOG0:
+			case Instruction::LOG1:
+			case Instruction::LOG2:
+			case Instruction::LOG3:
+			case Instruction::LOG4:
 			{
 				Id length = expr.arguments.at(1);
 				AssemblyItem offsetInstr(Instruction::SUB, expr.item->location());
@@ -381,12 +390,58 @@ void CSECodeGenerator::generateClassElement(Id _c, bool _allowSequenced)
 			}
 		}
 	}
-	else
-		assertThrow(
-			arguments.size() <= 2,
-			OptimizerException,
-			"Opcodes with more than two arguments not implemented yet."
-		);
+	else if (arguments.size() > 2)
+	{
+		// If the topmost elements are exactly the arguments (which is the case if they were
+		// just generated) and they are not needed anymore, bring them into the right order
+		// using swaps. Otherwise, copy all of them.
+		multiset<Id> topElements;
+		bool inPlace = true;
+		for (size_t i = 0; i < arguments.size() && inPlace; ++i)
+		{
+			int position = m_stackHeight - int(i);
+			inPlace = m_stack.count(position) && canBeRemoved(m_stack.at(position), _c, position);
+			if (inPlace)
+				topElements.insert(m_stack.at(position));
+		}
+		// canBeRemoved only checks single elements, so make sure that not all copies of an
+		// element are removed if it is still needed.
+		for (auto it = topElements.begin(); it != topElements.end() && inPlace; it = topElements.upper_bound(*it))
+			if (topElements.count(*it) > 1 && m_classPositions.at(*it).size() == topElements.count(*it))
+			{
+				if (m_finalClasses.count(*it))
+					inPlace = false;
+				auto range = m_neededBy.equal_range(*it);
+				for (auto need = range.first; need != range.second && inPlace; ++need)
+					if (need->second != _c && !m_classPositions.count(need->second))
+						inPlace = false;
+			}
+		if (inPlace && topElements == multiset<Id>(arguments.begin(), arguments.end()))
+		{
+			// Swap the topmost element into its target position, or, if it is already there,
+			// swap a misplaced element to the top. The latter has to be different from the
+			// topmost element, otherwise the swap would not change anything. Such an element
+			// always exists if anything is misplaced, because both multisets are equal.
+			auto element = [&](size_t _depth) { return m_stack.at(m_stackHeight - int(_depth)); };
+			auto misplaced = [&](size_t _depth) { return element(_depth) != arguments[_depth]; };
+			while (true)
+			{
+				size_t depth = 1;
+				if (misplaced(0))
+					while (!misplaced(depth) || arguments[depth] != element(0))
+						++depth;
+				else
+					while (depth < arguments.size() && (!misplaced(depth) || element(depth) == element(0)))
+						++depth;
+				if (depth == arguments.size())
+					break;
+				appendOrRemoveSwap(m_stackHeight - int(depth), itemLocation);
+			}
+		}
+		else
+			for (Id arg: boost::adaptors::reverse(arguments))
+				appendDup(classElementPosition(arg), itemLocation);
+	}
 	for (size_t i = 0; i < arguments.size(); ++i)
 		assertThrow(m_stack[m_stackHeight - i] == arguments[i], OptimizerException, "Expected arguments not present." );
 
@@ -65,12 +65,21 @@ public:
 
 	/// Feeds AssemblyItems into the eliminator and @returns the iterator pointing at the first
 	/// item that must be fed into a new instance of the eliminator.
+	/// @param _breakAtLogs if true, log instructions also end the block.
 	template <class _AssemblyItemIterator>
-	_AssemblyItemIterator feedItems(_AssemblyItemIterator _iterator, _AssemblyItemIterator _end);
+	_AssemblyItemIterator feedItems(
+		_AssemblyItemIterator _iterator,
+		_AssemblyItemIterator _end,
+		bool _breakAtLogs = false
+	);
 
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
+	/// @returns the knowledge about the state after the item that breaks the basic block,
+	/// only valid after getOptimizedItems has been called.
+	KnownState const& finalState() const { return m_initialState; }
+
 private:
 	/// Feeds the item into the system for analysis.
 	void feedItem(AssemblyItem const& _item, bool _copyItem = false);
@@ -168,11 +177,18 @@ private:
 template <class _AssemblyItemIterator>
 _AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 	_AssemblyItemIterator _iterator,
-	_AssemblyItemIterator _end
+	_AssemblyItemIterator _end,
+	bool _breakAtLogs
 )
 {
 	assertThrow(!m_breakingItem, OptimizerException, "Invalid use of CommonSubexpressionEliminator.");
-	for (; _iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator); ++_iterator)
+	for (
+		;
+		_iterator != _end &&
+		!SemanticInformation::breaksCSEAnalysisBlock(*_iterator) &&
+		!(_breakAtLogs && SemanticInformation::isLogInstruction(*_iterator));
+		++_iterator
+	)
 		feedItem(*_iterator);
 	if (_iterator != _end)
 		m_breakingItem = &(*_iterator++);
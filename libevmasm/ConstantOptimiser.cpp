@@ -26,11 +26,14 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+unsigned const ComputeMethodCache::defaultMaxDepth = 16;
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	Assembly& _assembly,
-	AssemblyItems& _items
+	AssemblyItems& _items,
+	ComputeMethodCache& _cache
 )
 {
 	unsigned optimisations = 0;
@@ -38,6 +41,7 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	for (AssemblyItem const& item: _items)
 		if (item.type() == Push)
 			pushes[item]++;
+	set<h256> const dataInSubs = _assembly.dataStoredInSubs();
 	map<u256, AssemblyItems> pendingReplacements;
 	for (auto it: pushes)
 	{
@@ -50,9 +54,9 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		params.runs = _runs;
 		LiteralMethod lit(params, item.data());
 		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
+		CodeCopyMethod copy(params, item.data(), dataInSubs.count(CodeCopyMethod::dataHash(item.data())));
 		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
+		ComputeMethod compute(params, item.data(), _cache);
 		bigint computeGas = compute.gasNeeded();
 		AssemblyItems replacement;
 		if (copyGas < literalGas && copyGas < computeGas)
@@ -137,8 +141,9 @@ bigint LiteralMethod::gasNeeded()
 	);
 }
 
-CodeCopyMethod::CodeCopyMethod(Params const& _params, u256 const& _value):
-	ConstantOptimisationMethod(_params, _value)
+CodeCopyMethod::CodeCopyMethod(Params const& _params, u256 const& _value, bool _isDataShared):
+	ConstantOptimisationMethod(_params, _value),
+	m_isDataShared(_isDataShared)
 {
 }
 
@@ -149,19 +154,26 @@ bigint CodeCopyMethod::gasNeeded()
 		simpleRunGas(copyRoutine()) + GasCosts::copyGas,
 		// Data gas for copy routines: Some bytes are zero, but we ignore them.
 		bytesRequired(copyRoutine()) * (m_params.isCreation ? GasCosts::txDataNonZeroGas : GasCosts::createDataGas),
-		// Data gas for data itself
-		dataGas(toBigEndian(m_value))
+		// Data gas for data itself, shared data is already paid for by the sub
+		m_isDataShared ? bigint(0) : dataGas(toBigEndian(m_value))
 	);
 }
 
 AssemblyItems CodeCopyMethod::execute(Assembly& _assembly)
 {
-	bytes data = toBigEndian(m_value);
 	AssemblyItems actualCopyRoutine = copyRoutine();
-	actualCopyRoutine[4] = _assembly.newData(data);
+	if (m_isDataShared)
+		actualCopyRoutine[4] = AssemblyItem(PushData, dataHash(m_value));
+	else
+		actualCopyRoutine[4] = _assembly.newData(toBigEndian(m_value));
 	return actualCopyRoutine;
 }
 
+h256 CodeCopyMethod::dataHash(u256 const& _value)
+{
+	return h256(dev::keccak256(asString(toBigEndian(_value))));
+}
+
 AssemblyItems const& CodeCopyMethod::copyRoutine() const
 {
 	AssemblyItems static copyRoutine{
@@ -180,20 +192,31 @@ AssemblyItems const& CodeCopyMethod::copyRoutine() const
 	return copyRoutine;
 }
 
-AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
+ComputeMethodCache::Representation const& ComputeMethod::findRepresentation(u256 const& _value, unsigned _depth)
 {
-	if (_value < 0x10000)
-		// Very small value, not worth computing
-		return AssemblyItems{_value};
+	ComputeMethodCache::Key key(_value, m_params.isCreation, m_params.runs, m_params.multiplicity, _depth);
+	auto cached = m_cache.m_representations.find(key);
+	if (cached != m_cache.m_representations.end())
+		return cached->second;
+
+	ComputeMethodCache::Representation representation;
+	if (_value < 0x10000 || _depth == 0)
+		// Very small value, not worth computing, or search depth exhausted
+		representation.routine = AssemblyItems{_value};
 	else if (dev::bytesRequired(~_value) < dev::bytesRequired(_value))
 		// Negated is shorter to represent
-		return findRepresentation(~_value) + AssemblyItems{Instruction::NOT};
+		representation.routine = findRepresentation(~_value, _depth - 1).routine + AssemblyItems{Instruction::NOT};
 	else
 	{
 		// Decompose value into a * 2**k + b where abs(b) << 2**k
 		// Is not always better, try literal and decomposition method.
+		// The gas costs of the parts of a routine add up, so candidates are compared
+		// without assembling them first.
 		AssemblyItems routine{u256(_value)};
 		bigint bestGas = gasNeeded(routine);
+		bigint const expGas = gasNeeded(AssemblyItems{u256(255), u256(2), Instruction::EXP});
+		bigint const addGas = gasNeeded(AssemblyItems{Instruction::ADD});
+		bigint const mulGas = gasNeeded(AssemblyItems{Instruction::MUL});
 		for (unsigned bits = 255; bits > 8; --bits)
 		{
 			unsigned gapDetector = unsigned(_value >> (bits - 8)) & 0x1ff;
@@ -208,26 +231,40 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 			if (abs(lowerPart) >= (powerOfTwo >> 8))
 				continue;
 
-			AssemblyItems newRoutine;
+			ComputeMethodCache::Representation const* lowerRepresentation = nullptr;
+			ComputeMethodCache::Representation const* upperRepresentation = nullptr;
+			bigint newGas = expGas;
 			if (lowerPart != 0)
-				newRoutine += findRepresentation(u256(abs(lowerPart)));
-			newRoutine += AssemblyItems{u256(bits), u256(2), Instruction::EXP};
+			{
+				lowerRepresentation = &findRepresentation(u256(abs(lowerPart)), _depth - 1);
+				newGas += lowerRepresentation->gas + addGas;
+			}
 			if (upperPart != 1 && upperPart != 0)
-				newRoutine += findRepresentation(upperPart) + AssemblyItems{Instruction::MUL};
+			{
+				upperRepresentation = &findRepresentation(upperPart, _depth - 1);
+				newGas += upperRepresentation->gas + mulGas;
+			}
+			if (newGas >= bestGas)
+				continue;
+
+			AssemblyItems newRoutine;
+			if (lowerRepresentation)
+				newRoutine += lowerRepresentation->routine;
+			newRoutine += AssemblyItems{u256(bits), u256(2), Instruction::EXP};
+			if (upperRepresentation)
+				newRoutine += upperRepresentation->routine + AssemblyItems{Instruction::MUL};
 			if (lowerPart > 0)
 				newRoutine += AssemblyItems{Instruction::ADD};
 			else if (lowerPart < 0)
 				newRoutine.push_back(Instruction::SUB);
 
-			bigint newGas = gasNeeded(newRoutine);
-			if (newGas < bestGas)
-			{
-				bestGas = move(newGas);
-				routine = move(newRoutine);
-			}
+			bestGas = move(newGas);
+			routine = move(newRoutine);
 		}
-		return routine;
+		representation.routine = move(routine);
 	}
+	representation.gas = gasNeeded(representation.routine);
+	return m_cache.m_representations.emplace(key, move(representation)).first->second;
 }
 
 bigint ComputeMethod::gasNeeded(AssemblyItems const& _routine)
@@ -22,8 +22,11 @@
 #pragma once
 
 #include <vector>
+#include <map>
+#include <tuple>
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
+#include <libdevcore/FixedHash.h>
 
 namespace dev
 {
@@ -34,6 +37,35 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
 
+/**
+ * Cache for the representations of constants found by ComputeMethod. It can be shared by all
+ * assemblies of a compilation and also bounds the depth of the recursive search.
+ */
+class ComputeMethodCache
+{
+public:
+	/// Default limit on the recursion depth of the search for a representation.
+	static unsigned const defaultMaxDepth;
+
+	explicit ComputeMethodCache(unsigned _maxDepth = defaultMaxDepth): m_maxDepth(_maxDepth) {}
+
+	unsigned maxDepth() const { return m_maxDepth; }
+
+private:
+	friend class ComputeMethod;
+
+	struct Representation
+	{
+		AssemblyItems routine;
+		bigint gas;
+	};
+	/// The value, the optimisation parameters and the remaining search depth.
+	using Key = std::tuple<u256, bool, size_t, size_t, unsigned>;
+
+	std::map<Key, Representation> m_representations;
+	unsigned m_maxDepth;
+};
+
 /**
  * Abstract base class for one way to change how constants are represented in the code.
  */
@@ -41,13 +73,16 @@ class ConstantOptimisationMethod
 {
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
-	/// @a _assembly and its @a _items.
+	/// @a _assembly and its @a _items. Constants that are already stored in the data section of
+	/// one of the subs of @a _assembly are shared with that sub instead of being stored again.
+	/// Representations computed by ComputeMethod are stored in and re-used from @a _cache.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		Assembly& _assembly,
-		AssemblyItems& _items
+		AssemblyItems& _items,
+		ComputeMethodCache& _cache
 	);
 
 	struct Params
@@ -108,16 +143,23 @@ public:
 
 /**
  * Method that stores the data in the .data section of the code and copies it to the stack.
+ * If the data is already stored in the bytecode of a sub assembly, it is copied from there.
  */
 class CodeCopyMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit CodeCopyMethod(Params const& _params, u256 const& _value);
+	explicit CodeCopyMethod(Params const& _params, u256 const& _value, bool _isDataShared = false);
 	virtual bigint gasNeeded() override;
 	virtual AssemblyItems execute(Assembly& _assembly) override;
 
+	/// @returns the hash under which the data for @a _value is stored in the assembly.
+	static h256 dataHash(u256 const& _value);
+
 protected:
 	AssemblyItems const& copyRoutine() const;
+
+	/// True if the data does not have to be stored because it is already part of a sub.
+	bool m_isDataShared = false;
 };
 
 /**
@@ -126,10 +168,11 @@ protected:
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
+	explicit ComputeMethod(Params const& _params, u256 const& _value, ComputeMethodCache& _cache):
+		ConstantOptimisationMethod(_params, _value),
+		m_cache(_cache)
 	{
-		m_routine = findRepresentation(m_value);
+		m_routine = findRepresentation(m_value, m_cache.maxDepth()).routine;
 	}
 
 	virtual bigint gasNeeded() override { return gasNeeded(m_routine); }
@@ -139,10 +182,12 @@ public:
 	}
 
 protected:
-	/// Tries to recursively find a way to compute @a _value.
-	AssemblyItems findRepresentation(u256 const& _value);
+	/// Tries to recursively find a way to compute @a _value, descending at most @a _depth levels.
+	/// Results are looked up in and stored to the cache.
+	ComputeMethodCache::Representation const& findRepresentation(u256 const& _value, unsigned _depth);
 	bigint gasNeeded(AssemblyItems const& _routine);
 
+	ComputeMethodCache& m_cache;
 	AssemblyItems m_routine;
 };
 
@@ -34,6 +34,15 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+namespace
+{
+/// @returns true if @a _tag refers to a tag of a sub assembly, which is only data in this assembly.
+bool isForeignTag(u256 const& _tag)
+{
+	return _tag >= (u256(1) << 64);
+}
+}
+
 BlockId::BlockId(u256 const& _id):
 	m_id(unsigned(_id))
 {
@@ -55,11 +64,38 @@ BasicBlocks ControlFlowGraph::optimisedBlocks()
 	return rebuildCode();
 }
 
+map<BlockId, KnownStatePointer> ControlFlowGraph::tagStates()
+{
+	map<BlockId, KnownStatePointer> states;
+	if (m_items.empty())
+		return states;
+
+	findLargestTag();
+	splitBlocks();
+	resolveNextLinks();
+	removeUnusedBlocks();
+	if (!gatherKnowledge(true))
+		// All tags could be reached from the unknown jump.
+		return states;
+
+	for (auto const& idAndBlock: m_blocks)
+	{
+		BasicBlock const& block = idAndBlock.second;
+		if (block.begin < block.end && m_items[block.begin].type() == Tag)
+		{
+			KnownStatePointer state = block.startState->copy();
+			state->clearTagUnions();
+			states[idAndBlock.first] = state;
+		}
+	}
+	return states;
+}
+
 void ControlFlowGraph::findLargestTag()
 {
 	m_lastUsedId = 0;
 	for (auto const& item: m_items)
-		if (item.type() == Tag || item.type() == PushTag)
+		if (item.type() == Tag || (item.type() == PushTag && !isForeignTag(item.data())))
 		{
 			// Assert that it can be converted.
 			BlockId(item.data());
@@ -86,7 +122,7 @@ void ControlFlowGraph::splitBlocks()
 			id = item.type() == Tag ? BlockId(item.data()) : generateNewId();
 			m_blocks[id].begin = index;
 		}
-		if (item.type() == PushTag)
+		if (item.type() == PushTag && !isForeignTag(item.data()))
 			m_blocks[id].pushedTags.push_back(BlockId(item.data()));
 		if (SemanticInformation::altersControlFlow(item))
 		{
@@ -122,6 +158,9 @@ void ControlFlowGraph::resolveNextLinks()
 		{
 		case BasicBlock::EndType::JUMPI:
 		case BasicBlock::EndType::HANDOVER:
+			if (block.end == m_items.size())
+				// Execution stops at the end of the code.
+				break;
 			assertThrow(
 				blockByBeginPos.count(block.end),
 				OptimizerException,
@@ -171,6 +210,8 @@ void ControlFlowGraph::setPrevLinks()
 		{
 		case BasicBlock::EndType::JUMPI:
 		case BasicBlock::EndType::HANDOVER:
+			if (!block.next)
+				break;
 			assertThrow(
 				!m_blocks.at(block.next).prev,
 				OptimizerException,
@@ -214,7 +255,7 @@ void ControlFlowGraph::setPrevLinks()
 	}
 }
 
-void ControlFlowGraph::gatherKnowledge()
+bool ControlFlowGraph::gatherKnowledge(bool _stopAtUnknownJump)
 {
 	// @todo actually we know that memory is filled with zeros at the beginning,
 	// we could make use of that.
@@ -279,8 +320,10 @@ void ControlFlowGraph::gatherKnowledge()
 			);
 			state->feedItem(m_items.at(pc++));
 
-			if (tags.empty())
+			if (tags.empty() || any_of(tags.begin(), tags.end(), isForeignTag))
 			{
+				if (_stopAtUnknownJump)
+					return false;
 				if (!unknownJumpEncountered)
 				{
 					// We do not know the target of this jump, so we have to reset the states of all
@@ -302,8 +345,8 @@ void ControlFlowGraph::gatherKnowledge()
 		block.endState = state;
 
 		if (
-			block.endType == BasicBlock::EndType::HANDOVER ||
-			block.endType == BasicBlock::EndType::JUMPI
+			(block.endType == BasicBlock::EndType::HANDOVER || block.endType == BasicBlock::EndType::JUMPI) &&
+			block.next
 		)
 			addWorkQueueItem(item, block.next, state);
 	}
@@ -316,6 +359,7 @@ void ControlFlowGraph::gatherKnowledge()
 			it = m_blocks.erase(it);
 		else
 			it++;
+	return true;
 }
 
 BasicBlocks ControlFlowGraph::rebuildCode()
@@ -91,8 +91,8 @@ using BasicBlocks = std::vector<BasicBlock>;
 
 /**
  * Control flow graph optimizer.
- * ASSUMES THAT WE ONLY JUMP TO TAGS THAT WERE PREVIOUSLY PUSHED. THIS IS NOT TRUE ANYMORE
- * NOW THAT FUNCTION TAGS CAN BE STORED IN STORAGE.
+ * optimisedBlocks ASSUMES THAT WE ONLY JUMP TO TAGS THAT WERE PREVIOUSLY PUSHED. THIS IS NOT TRUE
+ * ANYMORE NOW THAT FUNCTION TAGS CAN BE STORED IN STORAGE.
  */
 class ControlFlowGraph
 {
@@ -107,13 +107,22 @@ public:
 	/// @returns vector of basic blocks in the order they should be used in the final code.
 	/// Should be called only once.
 	BasicBlocks optimisedBlocks();
+	/// Performs the data flow analysis without modifying the code.
+	/// @returns the knowledge about the state at each tag that is reached by the analysis. Since
+	/// a jump to an unknown target resets the knowledge at all tags (and the result is empty in
+	/// that case), this also takes jumps to tags that are only stored in storage into account.
+	/// Should be called only once.
+	std::map<BlockId, KnownStatePointer> tagStates();
 
 private:
 	void findLargestTag();
 	void splitBlocks();
 	void resolveNextLinks();
 	void removeUnusedBlocks();
-	void gatherKnowledge();
+	/// Computes the knowledge at the start and end of each block.
+	/// @param _stopAtUnknownJump if true, stops the analysis at the first jump to an unknown target
+	/// @returns false if the analysis was stopped.
+	bool gatherKnowledge(bool _stopAtUnknownJump = false);
 	void setPrevLinks();
 	BasicBlocks rebuildCode();
 
@@ -32,6 +32,7 @@ struct AssemblyException: virtual Exception {};
 struct OptimizerException: virtual AssemblyException {};
 struct StackTooDeepException: virtual OptimizerException {};
 struct ItemNotAvailableException: virtual OptimizerException {};
+struct InvalidBinaryAssembly: virtual AssemblyException {};
 
 }
 }
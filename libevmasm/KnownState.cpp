@@ -22,6 +22,7 @@
  */
 
 #include "KnownState.h"
+#include <algorithm>
 #include <functional>
 #include <libdevcore/SHA3.h>
 #include <libevmasm/AssemblyItem.h>
@@ -141,6 +142,8 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 					m_stackHeight + _item.deposit(),
 					applySha3(arguments.at(0), arguments.at(1), _item.location())
 				);
+			else if (SemanticInformation::isLogInstruction(_item))
+				op = appendLog(_item.instruction(), arguments, _item.location());
 			else
 			{
 				bool invMem = SemanticInformation::invalidatesMemory(_item.instruction());
@@ -219,13 +222,20 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 
 	intersect(m_storageContent, _other.m_storageContent);
 	intersect(m_memoryContent, _other.m_memoryContent);
+	intersect(m_knownSha3Hashes, _other.m_knownSha3Hashes);
 	if (_combineSequenceNumbers)
 		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
+
+	removeAmbiguousKnowledge();
 }
 
 bool KnownState::operator==(KnownState const& _other) const
 {
-	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
+	if (
+		m_storageContent != _other.m_storageContent ||
+		m_memoryContent != _other.m_memoryContent ||
+		m_knownSha3Hashes != _other.m_knownSha3Hashes
+	)
 		return false;
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
 	auto thisIt = m_stackElements.cbegin();
@@ -385,6 +395,21 @@ KnownState::Id KnownState::applySha3(
 	return m_knownSha3Hashes[arguments] = v;
 }
 
+KnownState::StoreOperation KnownState::appendLog(
+	Instruction _instruction,
+	vector<Id> const& _arguments,
+	SourceLocation const& _location
+)
+{
+	// Logs only read memory, so all knowledge is retained.
+	m_sequenceNumber++;
+	AssemblyItem item(_instruction, _location);
+	Id id = m_expressionClasses->find(item, _arguments, true, m_sequenceNumber);
+	StoreOperation operation(StoreOperation::Log, id, m_sequenceNumber, id);
+	m_sequenceNumber++;
+	return operation;
+}
+
 set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 {
 	if (m_tagUnions.left.count(_expressionId))
@@ -397,6 +422,52 @@ set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 		return set<u256>();
 }
 
+void KnownState::removeAmbiguousKnowledge()
+{
+	map<Id, bool> ambiguous;
+	function<bool(Id)> isAmbiguous = [&](Id _id) -> bool
+	{
+		if (ambiguous.count(_id))
+			return ambiguous.at(_id);
+		bool result = false;
+		ExpressionClasses::Expression const& expr = m_expressionClasses->representative(_id);
+		if (expr.item && expr.item->type() == UndefinedItem)
+		{
+			// Classes created by newClass are unique and thus not ambiguous.
+			if (expr.item->data() != (u256(1) << 255) + _id)
+			{
+				int height = int(u2s(expr.item->data()));
+				result = !m_stackElements.count(height) || m_stackElements.at(height) != _id;
+			}
+		}
+		else
+			for (Id argument: expr.arguments)
+				if (isAmbiguous(argument))
+				{
+					result = true;
+					break;
+				}
+		return ambiguous[_id] = result;
+	};
+
+	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
+		if (isAmbiguous(it->second))
+			it = m_stackElements.erase(it);
+		else
+			++it;
+	for (auto* content: {&m_storageContent, &m_memoryContent})
+		for (auto it = content->begin(); it != content->end();)
+			if (isAmbiguous(it->first) || isAmbiguous(it->second))
+				it = content->erase(it);
+			else
+				++it;
+	for (auto it = m_knownSha3Hashes.begin(); it != m_knownSha3Hashes.end();)
+		if (isAmbiguous(it->second) || any_of(it->first.begin(), it->first.end(), isAmbiguous))
+			it = m_knownSha3Hashes.erase(it);
+		else
+			++it;
+}
+
 KnownState::Id KnownState::tagUnion(set<u256> _tags)
 {
 	if (m_tagUnions.right.count(_tags))
@@ -62,7 +62,9 @@ public:
 	using Id = ExpressionClasses::Id;
 	struct StoreOperation
 	{
-		enum Target { Invalid, Memory, Storage };
+		/// Logs do not write to a location, they use their own expression as slot, so every
+		/// log is kept and ordered with respect to memory writes.
+		enum Target { Invalid, Memory, Storage, Log };
 		StoreOperation(): target(Invalid), sequenceNumber(-1) {}
 		StoreOperation(
 			Target _target,
@@ -103,7 +105,8 @@ public:
 
 	/// Replaces the state by the intersection with _other, i.e. only equal knowledge is retained.
 	/// If the stack heighht is different, the smaller one is used and the stack is compared
-	/// relatively.
+	/// relatively. Knowledge that refers to unknown stack elements that are not at their initial
+	/// position anymore is removed.
 	/// @param _combineSequenceNumbers if true, sets the sequence number to the maximum of both
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
@@ -152,10 +155,19 @@ private:
 	Id loadFromMemory(Id _slot, SourceLocation const& _location);
 	/// Finds or creates a new expression that applies the sha3 hash function to the contents in memory.
 	Id applySha3(Id _start, Id _length, SourceLocation const& _location);
+	/// Increments the sequence number and creates a new expression for the log instruction
+	/// @a _instruction with the given arguments (memory start, length and topics).
+	/// @returns the corresponding store operation.
+	StoreOperation appendLog(Instruction _instruction, std::vector<Id> const& _arguments, SourceLocation const& _location);
 
 	/// @returns a new or already used Id representing the given set of tags.
 	Id tagUnion(std::set<u256> _tags);
 
+	/// Removes all knowledge that refers to unknown stack elements which are not at their initial
+	/// position. Such elements are identified by their stack height only, so after combining the
+	/// stacks of different paths, a new element at that height would be taken to be the old one.
+	void removeAmbiguousKnowledge();
+
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
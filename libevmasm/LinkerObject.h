@@ -39,8 +39,12 @@ struct LinkerObject
 	/// Map from offsets in bytecode to library identifiers. The addresses starting at those offsets
 	/// need to be replaced by the actual addresses by the linker.
 	std::map<size_t, std::string> linkReferences;
+	/// Offsets in bytecode at which the code of each assembly item starts, in the order of the items.
+	/// Only covers the items of the assembly itself, not those of its subassemblies.
+	std::vector<size_t> itemOffsets;
 
 	/// Appends the bytecode of @a _other and incorporates its link references.
+	/// The item offsets of @a _other are not incorporated since it is treated as data.
 	void append(LinkerObject const& _other);
 
 	/// Links the given libraries by replacing their uses in the code and removes them from the references.
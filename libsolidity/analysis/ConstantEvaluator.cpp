@@ -22,6 +22,7 @@
 
 #include <libsolidity/analysis/ConstantEvaluator.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 using namespace std;
 using namespace dev;
@@ -46,8 +47,20 @@ void ConstantEvaluator::endVisit(BinaryOperation const& _operation)
 	if (!dynamic_cast<RationalNumberType const*>(rightType.get()))
 		BOOST_THROW_EXCEPTION(_operation.rightExpression().createTypeError("Invalid constant expression."));
 	TypePointer commonType = leftType->binaryOperatorResult(_operation.getOperator(), rightType);
+	if (
+		!commonType &&
+		dynamic_cast<RationalNumberType const&>(*leftType).exceedsPrecision(
+			_operation.getOperator(),
+			dynamic_cast<RationalNumberType const&>(*rightType)
+		)
+	)
+		BOOST_THROW_EXCEPTION(_operation.createTypeError(
+			"Result of constant expression exceeds the precision limit of " +
+			to_string(RationalNumberType::maxBits) +
+			" bits."
+		));
 	if (Token::isCompareOp(_operation.getOperator()))
-		commonType = make_shared<BoolType>();
+		commonType = TypeProvider::boolean();
 	_operation.annotation().type = commonType;
 }
 
@@ -37,10 +37,12 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	auto visible = m_declarations.find(*_name);
+	if (visible != m_declarations.end())
+		declarations += visible->second;
+	auto invisible = m_invisibleDeclarations.find(*_name);
+	if (invisible != m_invisibleDeclarations.end())
+		declarations += invisible->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -93,25 +95,36 @@ bool DeclarationContainer::registerDeclaration(
 	if (_update)
 	{
 		solAssert(!dynamic_cast<FunctionDefinition const*>(&_declaration), "Attempt to update function definition.");
+		m_sortedDeclarations.erase(*_name);
 		m_declarations.erase(*_name);
 		m_invisibleDeclarations.erase(*_name);
 	}
 	else if (conflictingDeclaration(_declaration, _name))
 		return false;
 
-	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
-	if (!contains(decls, &_declaration))
-		decls.push_back(&_declaration);
+	Declarations* decls = nullptr;
+	if (_invisible)
+		decls = &m_invisibleDeclarations[*_name];
+	else
+	{
+		auto inserted = m_declarations.emplace(*_name, Declarations());
+		if (inserted.second)
+			m_sortedDeclarations[*_name] = &inserted.first->second;
+		decls = &inserted.first->second;
+	}
+	if (!contains(*decls, &_declaration))
+		decls->push_back(&_declaration);
 	return true;
 }
 
-std::vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _name, bool _recursive) const
+DeclarationContainer::Declarations const& DeclarationContainer::resolveName(ASTString const& _name, bool _recursive) const
 {
+	static Declarations const noDeclarations;
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	auto result = m_declarations.find(_name);
 	if (result != m_declarations.end())
 		return result->second;
 	if (_recursive && m_enclosingContainer)
 		return m_enclosingContainer->resolveName(_name, true);
-	return vector<Declaration const*>({});
+	return noDeclarations;
 }
@@ -24,6 +24,8 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include <boost/noncopyable.hpp>
 
 #include <libsolidity/ast/ASTForward.h>
@@ -40,6 +42,8 @@ namespace solidity
 class DeclarationContainer
 {
 public:
+	using Declarations = std::vector<Declaration const*>;
+
 	explicit DeclarationContainer(
 		ASTNode const* _enclosingNode = nullptr,
 		DeclarationContainer const* _enclosingContainer = nullptr
@@ -51,17 +55,24 @@ public:
 	/// @param _update if true, replaces a potential declaration that is already present
 	/// @returns false if the name was already declared.
 	bool registerDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr, bool _invisible = false, bool _update = false);
-	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false) const;
+	/// @returns the declarations visible under @a _name, the reference stays valid until the
+	/// declarations of the name are updated.
+	Declarations const& resolveName(ASTString const& _name, bool _recursive = false) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible names and their declarations, sorted by name so that diagnostics
+	/// about them appear in a deterministic order.
+	std::map<ASTString, Declarations const*> const& declarations() const { return m_sortedDeclarations; }
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
 private:
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::unordered_map<ASTString, Declarations> m_declarations;
+	std::unordered_map<ASTString, Declarations> m_invisibleDeclarations;
+	/// Elements of m_declarations sorted by name. Elements of an unordered_map keep their
+	/// address when it is rehashed.
+	std::map<ASTString, Declarations const*> m_sortedDeclarations;
 };
 
 }
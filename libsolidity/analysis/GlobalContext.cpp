@@ -25,6 +25,7 @@
 #include <libsolidity/analysis/GlobalContext.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 using namespace std;
 
@@ -37,7 +38,7 @@ GlobalContext::GlobalContext():
 m_magicVariables(vector<shared_ptr<MagicVariableDeclaration const>>{make_shared<MagicVariableDeclaration>("block", make_shared<MagicType>(MagicType::Kind::Block)),
 					make_shared<MagicVariableDeclaration>("msg", make_shared<MagicType>(MagicType::Kind::Message)),
 					make_shared<MagicVariableDeclaration>("tx", make_shared<MagicType>(MagicType::Kind::Transaction)),
-					make_shared<MagicVariableDeclaration>("now", make_shared<IntegerType>(256)),
+					make_shared<MagicVariableDeclaration>("now", TypeProvider::uint256()),
 					make_shared<MagicVariableDeclaration>("suicide",
 							make_shared<FunctionType>(strings{"address"}, strings{}, FunctionType::Location::Selfdestruct)),
 					make_shared<MagicVariableDeclaration>("selfdestruct",
@@ -87,7 +88,7 @@ MagicVariableDeclaration const* GlobalContext::currentThis() const
 {
 	if (!m_thisPointer[m_currentContract])
 		m_thisPointer[m_currentContract] = make_shared<MagicVariableDeclaration>(
-													"this", make_shared<ContractType>(*m_currentContract));
+													"this", TypeProvider::contract(*m_currentContract));
 	return m_thisPointer[m_currentContract].get();
 
 }
@@ -96,7 +97,7 @@ MagicVariableDeclaration const* GlobalContext::currentSuper() const
 {
 	if (!m_superPointer[m_currentContract])
 		m_superPointer[m_currentContract] = make_shared<MagicVariableDeclaration>(
-													"super", make_shared<ContractType>(*m_currentContract, true));
+													"super", TypeProvider::contract(*m_currentContract, true));
 	return m_superPointer[m_currentContract].get();
 }
 
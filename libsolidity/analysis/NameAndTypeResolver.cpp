@@ -55,7 +55,10 @@ bool NameAndTypeResolver::registerDeclarations(SourceUnit& _sourceUnit)
 	try
 	{
 		DeclarationRegistrationHelper registrar(m_scopes, _sourceUnit, m_errors);
-		_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
+		map<ASTString, vector<Declaration const*>> exportedSymbols;
+		for (auto const& nameAndDeclarations: m_scopes[&_sourceUnit]->declarations())
+			exportedSymbols[nameAndDeclarations.first] = *nameAndDeclarations.second;
+		_sourceUnit.annotation().exportedSymbols = move(exportedSymbols);
 	}
 	catch (FatalError const&)
 	{
@@ -119,7 +122,7 @@ bool NameAndTypeResolver::performImports(SourceUnit& _sourceUnit, map<string, So
 				}
 			else if (imp->name().empty())
 				for (auto const& nameAndDeclaration: scope->second->declarations())
-					for (auto const& declaration: nameAndDeclaration.second)
+					for (auto const& declaration: *nameAndDeclaration.second)
 						if (!target.registerDeclaration(*declaration, &nameAndDeclaration.first))
 						{
 							reportDeclarationError(
@@ -220,15 +223,16 @@ bool NameAndTypeResolver::updateDeclaration(Declaration const& _declaration)
 	return true;
 }
 
-vector<Declaration const*> NameAndTypeResolver::resolveName(ASTString const& _name, ASTNode const* _scope) const
+vector<Declaration const*> const& NameAndTypeResolver::resolveName(ASTString const& _name, ASTNode const* _scope) const
 {
+	static vector<Declaration const*> const noDeclarations;
 	auto iterator = m_scopes.find(_scope);
 	if (iterator == end(m_scopes))
-		return vector<Declaration const*>({});
+		return noDeclarations;
 	return iterator->second->resolveName(_name, false);
 }
 
-vector<Declaration const*> NameAndTypeResolver::nameFromCurrentScope(ASTString const& _name, bool _recursive) const
+vector<Declaration const*> const& NameAndTypeResolver::nameFromCurrentScope(ASTString const& _name, bool _recursive) const
 {
 	return m_currentScope->resolveName(_name, _recursive);
 }
@@ -236,15 +240,16 @@ vector<Declaration const*> NameAndTypeResolver::nameFromCurrentScope(ASTString c
 Declaration const* NameAndTypeResolver::pathFromCurrentScope(vector<ASTString> const& _path, bool _recursive) const
 {
 	solAssert(!_path.empty(), "");
-	vector<Declaration const*> candidates = m_currentScope->resolveName(_path.front(), _recursive);
-	for (size_t i = 1; i < _path.size() && candidates.size() == 1; i++)
+	vector<Declaration const*> const* candidates = &m_currentScope->resolveName(_path.front(), _recursive);
+	for (size_t i = 1; i < _path.size() && candidates->size() == 1; i++)
 	{
-		if (!m_scopes.count(candidates.front()))
+		auto scope = m_scopes.find(candidates->front());
+		if (scope == m_scopes.end())
 			return nullptr;
-		candidates = m_scopes.at(candidates.front())->resolveName(_path[i], false);
+		candidates = &scope->second->resolveName(_path[i], false);
 	}
-	if (candidates.size() == 1)
-		return candidates.front();
+	if (candidates->size() == 1)
+		return candidates->front();
 	else
 		return nullptr;
 }
@@ -294,7 +299,7 @@ void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
 	auto iterator = m_scopes.find(&_base);
 	solAssert(iterator != end(m_scopes), "");
 	for (auto const& nameAndDeclaration: iterator->second->declarations())
-		for (auto const& declaration: nameAndDeclaration.second)
+		for (auto const& declaration: *nameAndDeclaration.second)
 			// Import if it was declared in the base, is not the constructor and is visible in derived classes
 			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
 				if (!m_currentScope->registerDeclaration(*declaration))
@@ -457,7 +462,7 @@ void NameAndTypeResolver::reportFatalTypeError(Error const& _e)
 }
 
 DeclarationRegistrationHelper::DeclarationRegistrationHelper(
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ASTNode& _astRoot,
 	ErrorList& _errors
 ):
@@ -577,7 +582,7 @@ void DeclarationRegistrationHelper::endVisit(EventDefinition&)
 
 void DeclarationRegistrationHelper::enterNewSubScope(Declaration const& _declaration)
 {
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
 	bool newlyAdded;
 	shared_ptr<DeclarationContainer> container(new DeclarationContainer(m_currentScope, m_scopes[m_currentScope].get()));
 	tie(iter, newlyAdded) = m_scopes.emplace(&_declaration, move(container));
@@ -22,6 +22,7 @@
 
 #include <libsolidity/analysis/ReferencesResolver.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/analysis/ConstantEvaluator.h>
@@ -48,7 +49,7 @@ bool ReferencesResolver::resolve(ASTNode const& _root)
 
 bool ReferencesResolver::visit(Identifier const& _identifier)
 {
-	auto declarations = m_resolver.nameFromCurrentScope(_identifier.name());
+	auto const& declarations = m_resolver.nameFromCurrentScope(_identifier.name());
 	if (declarations.empty())
 		fatalDeclarationError(_identifier.location(), "Undeclared identifier.");
 	else if (declarations.size() == 1)
@@ -74,11 +75,11 @@ void ReferencesResolver::endVisit(UserDefinedTypeName const& _typeName)
 	_typeName.annotation().referencedDeclaration = declaration;
 
 	if (StructDefinition const* structDef = dynamic_cast<StructDefinition const*>(declaration))
-		_typeName.annotation().type = make_shared<StructType>(*structDef);
+		_typeName.annotation().type = TypeProvider::structType(*structDef);
 	else if (EnumDefinition const* enumDef = dynamic_cast<EnumDefinition const*>(declaration))
-		_typeName.annotation().type = make_shared<EnumType>(*enumDef);
+		_typeName.annotation().type = TypeProvider::enumType(*enumDef);
 	else if (ContractDefinition const* contract = dynamic_cast<ContractDefinition const*>(declaration))
-		_typeName.annotation().type = make_shared<ContractType>(*contract);
+		_typeName.annotation().type = TypeProvider::contract(*contract);
 	else
 		fatalTypeError(_typeName.location(), "Name has to refer to a struct, enum or contract.");
 }
@@ -146,7 +147,7 @@ bool ReferencesResolver::visit(InlineAssembly const& _inlineAssembly)
 	ErrorList errorsIgnored;
 	assembly::CodeGenerator codeGen(_inlineAssembly.operations(), errorsIgnored);
 	codeGen.typeCheck([&](assembly::Identifier const& _identifier, eth::Assembly&, assembly::CodeGenerator::IdentifierContext) {
-		auto declarations = m_resolver.nameFromCurrentScope(_identifier.name);
+		auto const& declarations = m_resolver.nameFromCurrentScope(_identifier.name);
 		if (declarations.size() != 1)
 			return false;
 		_inlineAssembly.annotation().externalReferences[&_identifier] = declarations.front();
@@ -24,6 +24,8 @@
 #include <memory>
 #include <boost/range/adaptor/reversed.hpp>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libdevcore/SHA3.h>
 #include <libevmasm/Assembly.h> // needed for inline assembly
 #include <libsolidity/inlineasm/AsmCodeGen.h>
 
@@ -34,9 +36,50 @@ using namespace dev::solidity;
 
 bool TypeChecker::checkTypeRequirements(ContractDefinition const& _contract)
 {
+	checkContractDefinition(_contract);
+	checkContractMembers(_contract);
+	return registerContractCreations();
+}
+
+bool TypeChecker::checkContractDefinition(ContractDefinition const& _contract)
+{
+	m_scope = &_contract;
+	return performChecks([&]() { visitContractDefinition(_contract); });
+}
+
+bool TypeChecker::checkContractMembers(ContractDefinition const& _contract)
+{
+	solAssert(m_scope == &_contract, "Contract definition not yet checked.");
+	return performChecks([&]() { visitContractMembers(_contract); });
+}
+
+bool TypeChecker::registerContractCreations()
+{
+	solAssert(!!m_scope, "");
+	size_t insertedErrors = 0;
+	for (auto const& creation: m_contractCreations)
+	{
+		m_scope->annotation().contractDependencies.insert(creation.contract);
+		if (contractDependenciesAreCyclic(*m_scope))
+		{
+			auto err = make_shared<Error>(Error::Type::TypeError);
+			*err <<
+				errinfo_sourceLocation(creation.location) <<
+				errinfo_comment("Circular reference for contract creation (cannot create instance of derived or same contract).");
+			m_errors.insert(m_errors.begin() + creation.errorPosition + insertedErrors++, err);
+		}
+	}
+	m_contractCreations.clear();
+	return !m_fatalErrorOccurred && Error::containsOnlyWarnings(m_errors);
+}
+
+bool TypeChecker::performChecks(function<void()> const& _checks)
+{
+	if (m_fatalErrorOccurred)
+		return false;
 	try
 	{
-		visit(_contract);
+		_checks();
 	}
 	catch (FatalError const&)
 	{
@@ -44,6 +87,7 @@ bool TypeChecker::checkTypeRequirements(ContractDefinition const& _contract)
 		// continue normally from here.
 		if (m_errors.empty())
 			throw; // Something is weird here, rather throw again.
+		m_fatalErrorOccurred = true;
 	}
 	return Error::containsOnlyWarnings(m_errors);
 }
@@ -60,10 +104,8 @@ TypePointer const& TypeChecker::type(VariableDeclaration const& _variable) const
 	return _variable.annotation().type;
 }
 
-bool TypeChecker::visit(ContractDefinition const& _contract)
+void TypeChecker::visitContractDefinition(ContractDefinition const& _contract)
 {
-	m_scope = &_contract;
-
 	// We force our own visiting order here.
 	//@TODO structs will be visited again below, but it is probably fine.
 	ASTNode::listAccept(_contract.definedStructs(), *this);
@@ -73,6 +115,7 @@ bool TypeChecker::visit(ContractDefinition const& _contract)
 	checkContractIllegalOverrides(_contract);
 	checkContractAbstractFunctions(_contract);
 	checkContractAbstractConstructors(_contract);
+	annotateExternalSignatures(_contract);
 
 	FunctionDefinition const* function = _contract.constructor();
 	if (function)
@@ -114,7 +157,10 @@ bool TypeChecker::visit(ContractDefinition const& _contract)
 		if (!function->isImplemented())
 			_contract.annotation().isFullyImplemented = false;
 	}
+}
 
+void TypeChecker::visitContractMembers(ContractDefinition const& _contract)
+{
 	ASTNode::listAccept(_contract.subNodes(), *this);
 
 	checkContractExternalTypeClashes(_contract);
@@ -133,8 +179,6 @@ bool TypeChecker::visit(ContractDefinition const& _contract)
 
 	if (_contract.isLibrary())
 		checkLibraryRequirements(_contract);
-
-	return false;
 }
 
 void TypeChecker::checkContractDuplicateFunctions(ContractDefinition const& _contract)
@@ -180,10 +224,9 @@ void TypeChecker::checkContractDuplicateFunctions(ContractDefinition const& _con
 
 void TypeChecker::checkContractAbstractFunctions(ContractDefinition const& _contract)
 {
-	// Mapping from name to function definition (exactly one per argument type equality class) and
-	// flag to indicate whether it is fully implemented.
-	using FunTypeAndFlag = std::pair<FunctionTypePointer, bool>;
-	map<string, vector<FunTypeAndFlag>> functions;
+	// Mapping from chains of overriding functions to a flag that indicates whether the chain
+	// is fully implemented.
+	map<ContractDefinition::OverrideChain const*, bool> implemented;
 
 	// Search from base to derived
 	for (ContractDefinition const* contract: boost::adaptors::reverse(_contract.annotation().linearizedBaseContracts))
@@ -192,14 +235,9 @@ void TypeChecker::checkContractAbstractFunctions(ContractDefinition const& _cont
 			// Take constructors out of overload hierarchy
 			if (function->isConstructor())
 				continue;
-			auto& overloads = functions[function->name()];
-			FunctionTypePointer funType = make_shared<FunctionType>(*function);
-			auto it = find_if(overloads.begin(), overloads.end(), [&](FunTypeAndFlag const& _funAndFlag)
-			{
-				return funType->hasEqualArgumentTypes(*_funAndFlag.first);
-			});
-			if (it == overloads.end())
-				overloads.push_back(make_pair(funType, function->isImplemented()));
+			auto it = implemented.find(&_contract.overrideChain(*function));
+			if (it == implemented.end())
+				implemented[&_contract.overrideChain(*function)] = function->isImplemented();
 			else if (it->second)
 			{
 				if (!function->isImplemented())
@@ -210,13 +248,12 @@ void TypeChecker::checkContractAbstractFunctions(ContractDefinition const& _cont
 		}
 
 	// Set to not fully implemented if at least one flag is false.
-	for (auto const& it: functions)
-		for (auto const& funAndFlag: it.second)
-			if (!funAndFlag.second)
-			{
-				_contract.annotation().isFullyImplemented = false;
-				return;
-			}
+	for (auto const& it: implemented)
+		if (!it.second)
+		{
+			_contract.annotation().isFullyImplemented = false;
+			return;
+		}
 }
 
 void TypeChecker::checkContractAbstractConstructors(ContractDefinition const& _contract)
@@ -260,7 +297,7 @@ void TypeChecker::checkContractIllegalOverrides(ContractDefinition const& _contr
 {
 	// TODO unify this at a later point. for this we need to put the constness and the access specifier
 	// into the types
-	map<string, vector<FunctionDefinition const*>> functions;
+	set<string> functions;
 	map<string, ModifierDefinition const*> modifiers;
 
 	// We search from derived to base, so the stored item causes the error.
@@ -273,22 +310,26 @@ void TypeChecker::checkContractIllegalOverrides(ContractDefinition const& _contr
 			string const& name = function->name();
 			if (modifiers.count(name))
 				typeError(modifiers[name]->location(), "Override changes function to modifier.");
-			FunctionType functionType(*function);
-			// function should not change the return type
-			for (FunctionDefinition const* overriding: functions[name])
+			// The functions preceding this one in its override chain override it.
+			ContractDefinition::OverrideChain const& chain = _contract.overrideChain(*function);
+			if (chain.front() != function)
 			{
-				FunctionType overridingType(*overriding);
-				if (!overridingType.hasEqualArgumentTypes(functionType))
-					continue;
-				if (
-					overriding->visibility() != function->visibility() ||
-					overriding->isDeclaredConst() != function->isDeclaredConst() ||
-					overriding->isPayable() != function->isPayable() ||
-					overridingType != functionType
-				)
-					typeError(overriding->location(), "Override changes extended function signature.");
+				FunctionType functionType(*function);
+				// function should not change the return type
+				for (FunctionDefinition const* overriding: chain)
+				{
+					if (overriding == function)
+						break;
+					if (
+						overriding->visibility() != function->visibility() ||
+						overriding->isDeclaredConst() != function->isDeclaredConst() ||
+						overriding->isPayable() != function->isPayable() ||
+						FunctionType(*overriding) != functionType
+					)
+						typeError(overriding->location(), "Override changes extended function signature.");
+				}
 			}
-			functions[name].push_back(function);
+			functions.insert(name);
 		}
 		for (ModifierDefinition const* modifier: contract->functionModifiers())
 		{
@@ -298,12 +339,34 @@ void TypeChecker::checkContractIllegalOverrides(ContractDefinition const& _contr
 				override = modifier;
 			else if (ModifierType(*override) != ModifierType(*modifier))
 				typeError(override->location(), "Override changes modifier signature.");
-			if (!functions[name].empty())
+			if (functions.count(name))
 				typeError(override->location(), "Override changes modifier to function.");
 		}
 	}
 }
 
+void TypeChecker::annotateExternalSignatures(ContractDefinition const& _contract)
+{
+	auto annotate = [](ExternalSignatureAnnotation& _annotation, FunctionType const& _function)
+	{
+		// Functions with types that cannot be used externally do not have a signature,
+		// this is reported elsewhere.
+		if (!_function.interfaceFunctionType())
+			return;
+		string signature = _function.externalSignature();
+		_annotation.externalSignatureHash = dev::keccak256(signature);
+		_annotation.externalSignature = move(signature);
+	};
+	for (FunctionDefinition const* function: _contract.definedFunctions())
+		if (function->isPartOfExternalInterface())
+			annotate(function->annotation(), FunctionType(*function));
+	for (VariableDeclaration const* variable: _contract.stateVariables())
+		if (variable->isPartOfExternalInterface())
+			annotate(variable->annotation(), FunctionType(*variable));
+	for (EventDefinition const* event: _contract.events())
+		annotate(event->annotation(), FunctionType(*event));
+}
+
 void TypeChecker::checkContractExternalTypeClashes(ContractDefinition const& _contract)
 {
 	map<string, vector<pair<Declaration const*, FunctionTypePointer>>> externalDeclarations;
@@ -312,7 +375,7 @@ void TypeChecker::checkContractExternalTypeClashes(ContractDefinition const& _co
 		for (FunctionDefinition const* f: contract->definedFunctions())
 			if (f->isPartOfExternalInterface())
 			{
-				auto functionType = make_shared<FunctionType>(*f);
+				auto functionType = TypeProvider::function(*f);
 				// under non error circumstances this should be true
 				if (functionType->interfaceFunctionType())
 					externalDeclarations[functionType->externalSignature()].push_back(
@@ -645,7 +708,7 @@ bool TypeChecker::visit(InlineAssembly const& _inlineAssembly)
 
 bool TypeChecker::visit(IfStatement const& _ifStatement)
 {
-	expectType(_ifStatement.condition(), BoolType());
+	expectType(_ifStatement.condition(), *TypeProvider::boolean());
 	_ifStatement.trueStatement().accept(*this);
 	if (_ifStatement.falseStatement())
 		_ifStatement.falseStatement()->accept(*this);
@@ -654,7 +717,7 @@ bool TypeChecker::visit(IfStatement const& _ifStatement)
 
 bool TypeChecker::visit(WhileStatement const& _whileStatement)
 {
-	expectType(_whileStatement.condition(), BoolType());
+	expectType(_whileStatement.condition(), *TypeProvider::boolean());
 	_whileStatement.body().accept(*this);
 	return false;
 }
@@ -664,7 +727,7 @@ bool TypeChecker::visit(ForStatement const& _forStatement)
 	if (_forStatement.initializationExpression())
 		_forStatement.initializationExpression()->accept(*this);
 	if (_forStatement.condition())
-		expectType(*_forStatement.condition(), BoolType());
+		expectType(*_forStatement.condition(), *TypeProvider::boolean());
 	if (_forStatement.loopExpression())
 		_forStatement.loopExpression()->accept(*this);
 	_forStatement.body().accept(*this);
@@ -884,7 +947,7 @@ void TypeChecker::endVisit(ExpressionStatement const& _statement)
 
 bool TypeChecker::visit(Conditional const& _conditional)
 {
-	expectType(_conditional.condition(), BoolType());
+	expectType(_conditional.condition(), *TypeProvider::boolean());
 
 	_conditional.trueExpression().accept(*this);
 	_conditional.falseExpression().accept(*this);
@@ -1069,6 +1132,14 @@ void TypeChecker::endVisit(BinaryOperation const& _operation)
 	TypePointer commonType = leftType->binaryOperatorResult(_operation.getOperator(), rightType);
 	if (!commonType)
 	{
+		string reason;
+		auto leftRational = dynamic_cast<RationalNumberType const*>(leftType.get());
+		auto rightRational = dynamic_cast<RationalNumberType const*>(rightType.get());
+		if (leftRational && rightRational && leftRational->exceedsPrecision(_operation.getOperator(), *rightRational))
+			reason =
+				": the result exceeds the precision limit of " +
+				to_string(RationalNumberType::maxBits) +
+				" bits for rational constants.";
 		typeError(
 			_operation.location(),
 			"Operator " +
@@ -1076,14 +1147,15 @@ void TypeChecker::endVisit(BinaryOperation const& _operation)
 			" not compatible with types " +
 			leftType->toString() +
 			" and " +
-			rightType->toString()
+			rightType->toString() +
+			reason
 		);
 		commonType = leftType;
 	}
 	_operation.annotation().commonType = commonType;
 	_operation.annotation().type =
 		Token::isCompareOp(_operation.getOperator()) ?
-		make_shared<BoolType>() :
+		TypeProvider::boolean() :
 		commonType;
 }
 
@@ -1287,16 +1359,13 @@ void TypeChecker::endVisit(NewExpression const& _newExpression)
 			typeError(_newExpression.location(), "Contract with internal constructor cannot be created directly.");
 
 		solAssert(!!m_scope, "");
-		m_scope->annotation().contractDependencies.insert(contract);
 		solAssert(
 			!contract->annotation().linearizedBaseContracts.empty(),
 			"Linearized base contracts not yet available."
 		);
-		if (contractDependenciesAreCyclic(*m_scope))
-			typeError(
-				_newExpression.location(),
-				"Circular reference for contract creation (cannot create instance of derived or same contract)."
-			);
+		// Dependencies of other contracts might still change concurrently, so the check for
+		// cycles is deferred to registerContractCreations.
+		m_contractCreations.push_back(ContractCreation{contract, _newExpression.location(), m_errors.size()});
 
 		_newExpression.annotation().type = FunctionType::newExpressionType(*contract);
 	}
@@ -1314,7 +1383,7 @@ void TypeChecker::endVisit(NewExpression const& _newExpression)
 			);
 		type = ReferenceType::copyForLocationIfReference(DataLocation::Memory, type);
 		_newExpression.annotation().type = make_shared<FunctionType>(
-			TypePointers{make_shared<IntegerType>(256)},
+			TypePointers{TypeProvider::uint256()},
 			TypePointers{type},
 			strings(),
 			strings(),
@@ -1483,7 +1552,7 @@ bool TypeChecker::visit(IndexAccess const& _access)
 				if (bytesType.numBytes() <= integerType->literalValue(nullptr))
 					typeError(_access.location(), "Out of bounds array access.");
 		}
-		resultType = make_shared<FixedBytesType>(1);
+		resultType = TypeProvider::fixedBytes(1);
 		isLValue = false; // @todo this heavily depends on how it is embedded
 		break;
 	}
@@ -1569,7 +1638,7 @@ void TypeChecker::endVisit(Literal const& _literal)
 	{
 		if (_literal.passesAddressChecksum())
 		{
-			_literal.annotation().type = make_shared<IntegerType>(0, IntegerType::Modifier::Address);
+			_literal.annotation().type = TypeProvider::address();
 			return;
 		}
 		else
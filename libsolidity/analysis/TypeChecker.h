@@ -28,6 +28,8 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/ASTVisitor.h>
 
+#include <functional>
+
 namespace dev
 {
 namespace solidity
@@ -49,6 +51,21 @@ public:
 	/// @returns true iff all checks passed. Note even if all checks passed, errors() can still contain warnings
 	bool checkTypeRequirements(ContractDefinition const& _contract);
 
+	/// The three steps performed by checkTypeRequirements, which allow to check the members
+	/// of different contracts concurrently (each with its own type checker and error list).
+	/// checkContractDefinition checks the contract itself (inheritance, overrides, constructor
+	/// and fallback function) and has to be run for all contracts before checkContractMembers
+	/// is run for any of them, since the latter relies on annotations set by the former.
+	/// checkContractMembers only modifies annotations inside the contract and can be run
+	/// concurrently for different contracts.
+	/// registerContractCreations adds the contracts created by the contract to its dependencies
+	/// and checks them for cycles. It has to be run sequentially and in the same order
+	/// for all contracts.
+	/// @returns true iff all checks so far passed.
+	bool checkContractDefinition(ContractDefinition const& _contract);
+	bool checkContractMembers(ContractDefinition const& _contract);
+	bool registerContractCreations();
+
 	/// @returns the type of an expression and asserts that it is present.
 	TypePointer const& type(Expression const& _expression) const;
 	/// @returns the type of the given variable and throws if the type is not present
@@ -65,13 +82,21 @@ private:
 	/// Adds a new error to the list of errors and throws to abort type checking.
 	void fatalTypeError(SourceLocation const& _location, std::string const& _description);
 
-	virtual bool visit(ContractDefinition const& _contract) override;
+	/// Runs @a _checks, catching fatal errors. No further checks are run after a fatal error.
+	/// @returns true iff all checks so far passed.
+	bool performChecks(std::function<void()> const& _checks);
+
+	void visitContractDefinition(ContractDefinition const& _contract);
+	void visitContractMembers(ContractDefinition const& _contract);
 	/// Checks that two functions defined in this contract with the same name have different
 	/// arguments and that there is at most one constructor.
 	void checkContractDuplicateFunctions(ContractDefinition const& _contract);
 	void checkContractIllegalOverrides(ContractDefinition const& _contract);
 	void checkContractAbstractFunctions(ContractDefinition const& _contract);
 	void checkContractAbstractConstructors(ContractDefinition const& _contract);
+	/// Computes the external signatures and their hashes of all functions, public state variables
+	/// and events defined in the contract and stores them in their annotations.
+	void annotateExternalSignatures(ContractDefinition const& _contract);
 	/// Checks that different functions with external visibility end up having different
 	/// external argument types (i.e. different signature).
 	void checkContractExternalTypeClashes(ContractDefinition const& _contract);
@@ -124,7 +149,18 @@ private:
 	/// Runs type checks on @a _expression to infer its type and then checks that it is an LValue.
 	void requireLValue(Expression const& _expression);
 
+	/// Contract created by a "new" expression, together with the size of the error list at
+	/// that point, which is where errors about the creation are inserted.
+	struct ContractCreation
+	{
+		ContractDefinition const* contract;
+		SourceLocation location;
+		size_t errorPosition;
+	};
+
 	ContractDefinition const* m_scope = nullptr;
+	std::vector<ContractCreation> m_contractCreations;
+	bool m_fatalErrorOccurred = false;
 
 	ErrorList& m_errors;
 };
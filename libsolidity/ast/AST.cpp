@@ -25,6 +25,7 @@
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/ast/AST_accept.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libdevcore/SHA3.h>
 
@@ -37,18 +38,19 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
+/// Hands out node IDs, separately for each thread so that sources can be parsed concurrently.
 class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static size_t last() { return instance(); }
+	static void reset(size_t _lastID) { instance() = _lastID; }
 private:
 	static size_t& instance()
 	{
-		static IDDispenser dispenser;
-		return dispenser.id;
+		static thread_local size_t id = 0;
+		return id;
 	}
-	size_t id = 0;
 };
 
 ASTNode::ASTNode(SourceLocation const& _location):
@@ -62,16 +64,25 @@ ASTNode::~ASTNode()
 	delete m_annotation;
 }
 
-void ASTNode::resetID()
+void ASTNode::resetID(size_t _lastID)
 {
-	IDDispenser::reset();
+	IDDispenser::reset(_lastID);
+}
+
+size_t ASTNode::lastID()
+{
+	return IDDispenser::last();
+}
+
+void ASTNode::clearAnalysisData()
+{
+	delete m_annotation;
+	m_annotation = nullptr;
 }
 
 ASTAnnotation& ASTNode::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ASTAnnotation();
-	return *m_annotation;
+	return initAnnotation<ASTAnnotation>();
 }
 
 Error ASTNode::createTypeError(string const& _description) const
@@ -79,11 +90,52 @@ Error ASTNode::createTypeError(string const& _description) const
 	return Error(Error::Type::TypeError) << errinfo_sourceLocation(location()) << errinfo_comment(_description);
 }
 
+namespace
+{
+
+/// Collects all nodes reachable from a source unit, including the identifiers of import
+/// aliases, which are not visited by accept.
+class NodeCollector: public ASTVisitor
+{
+public:
+	vector<ASTNode*> nodes;
+
+	virtual bool visit(ImportDirective& _import) override
+	{
+		for (auto const& alias: _import.symbolAliases())
+			nodes.push_back(alias.first.get());
+		return visitNode(_import);
+	}
+
+protected:
+	virtual bool visitNode(ASTNode& _node) override
+	{
+		nodes.push_back(&_node);
+		return true;
+	}
+};
+
+}
+
+void SourceUnit::shiftIDs(size_t _offset)
+{
+	NodeCollector collector;
+	accept(collector);
+	for (ASTNode* node: collector.nodes)
+		node->m_id += _offset;
+}
+
+void SourceUnit::clearAnnotations()
+{
+	NodeCollector collector;
+	accept(collector);
+	for (ASTNode* node: collector.nodes)
+		node->clearAnalysisData();
+}
+
 SourceUnitAnnotation& SourceUnit::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new SourceUnitAnnotation();
-	return static_cast<SourceUnitAnnotation&>(*m_annotation);
+	return initAnnotation<SourceUnitAnnotation>();
 }
 
 string Declaration::sourceUnitName() const
@@ -97,9 +149,7 @@ string Declaration::sourceUnitName() const
 
 ImportAnnotation& ImportDirective::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ImportAnnotation();
-	return static_cast<ImportAnnotation&>(*m_annotation);
+	return initAnnotation<ImportAnnotation>();
 }
 
 TypePointer ImportDirective::type() const
@@ -110,7 +160,7 @@ TypePointer ImportDirective::type() const
 
 map<FixedHash<4>, FunctionTypePointer> ContractDefinition::interfaceFunctions() const
 {
-	auto exportedFunctionList = interfaceFunctionList();
+	auto const& exportedFunctionList = interfaceFunctionList();
 
 	map<FixedHash<4>, FunctionTypePointer> exportedFunctions;
 	for (auto const& it: exportedFunctionList)
@@ -143,6 +193,7 @@ FunctionDefinition const* ContractDefinition::fallbackFunction() const
 
 vector<EventDefinition const*> const& ContractDefinition::interfaceEvents() const
 {
+	lock_guard<recursive_mutex> lock(m_cacheMutex);
 	if (!m_interfaceEvents)
 	{
 		set<string> eventsSeen;
@@ -160,6 +211,7 @@ vector<EventDefinition const*> const& ContractDefinition::interfaceEvents() cons
 
 vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::interfaceFunctionList() const
 {
+	lock_guard<recursive_mutex> lock(m_cacheMutex);
 	if (!m_interfaceFunctionList)
 	{
 		set<string> functionsSeen;
@@ -169,8 +221,9 @@ vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::inter
 		{
 			vector<FunctionTypePointer> functions;
 			for (FunctionDefinition const* f: contract->definedFunctions())
-				if (f->isPartOfExternalInterface())
-					functions.push_back(make_shared<FunctionType>(*f, false));
+				// Overridden functions have the same signature as their override.
+				if (f->isPartOfExternalInterface() && overrideChain(*f).front() == f)
+					functions.push_back(TypeProvider::function(*f, false));
 			for (VariableDeclaration const* v: contract->stateVariables())
 				if (v->isPartOfExternalInterface())
 					functions.push_back(make_shared<FunctionType>(*v));
@@ -183,7 +236,7 @@ vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::inter
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
 					signaturesSeen.insert(functionSignature);
-					FixedHash<4> hash(dev::keccak256(functionSignature));
+					FixedHash<4> hash(fun->externalSignatureHash());
 					m_interfaceFunctionList->push_back(make_pair(hash, fun));
 				}
 			}
@@ -192,6 +245,38 @@ vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::inter
 	return *m_interfaceFunctionList;
 }
 
+ContractDefinition::OverrideChain const& ContractDefinition::overrideChain(FunctionDefinition const& _function) const
+{
+	lock_guard<recursive_mutex> lock(m_cacheMutex);
+	if (!m_overrideChains)
+	{
+		m_overrideChains.reset(new unordered_map<FunctionDefinition const*, shared_ptr<OverrideChain>>());
+		// Functions override each other iff they have the same name and parameter types, so
+		// they are grouped by their name and the identifiers of their parameter types.
+		unordered_map<string, shared_ptr<OverrideChain>> chains;
+		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
+			for (FunctionDefinition const* function: contract->definedFunctions())
+			{
+				if (function->isConstructor())
+					continue;
+				string key = function->name() + "(";
+				for (ASTPointer<VariableDeclaration> const& parameter: function->parameters())
+				{
+					solAssert(parameter->annotation().type, "Parameter types not yet resolved.");
+					key += parameter->annotation().type->identifier() + ",";
+				}
+				shared_ptr<OverrideChain>& chain = chains[key];
+				if (!chain)
+					chain = make_shared<OverrideChain>();
+				chain->push_back(function);
+				(*m_overrideChains)[function] = chain;
+			}
+	}
+	auto chain = m_overrideChains->find(&_function);
+	solAssert(chain != m_overrideChains->end(), "Function " + _function.name() + " not found in inheritance hierarchy.");
+	return *chain->second;
+}
+
 Json::Value const& ContractDefinition::devDocumentation() const
 {
 	return m_devDocumentation;
@@ -207,6 +292,18 @@ void ContractDefinition::setDevDocumentation(Json::Value const& _devDocumentatio
 	m_devDocumentation = _devDocumentation;
 }
 
+void ContractDefinition::clearAnalysisData()
+{
+	ASTNode::clearAnalysisData();
+	m_userDocumentation = Json::Value();
+	m_devDocumentation = Json::Value();
+	m_linearizedBaseContracts.clear();
+	m_interfaceFunctionList.reset();
+	m_overrideChains.reset();
+	m_interfaceEvents.reset();
+	m_inheritableMembers.reset();
+}
+
 void ContractDefinition::setUserDocumentation(Json::Value const& _userDocumentation)
 {
 	m_userDocumentation = _userDocumentation;
@@ -214,6 +311,7 @@ void ContractDefinition::setUserDocumentation(Json::Value const& _userDocumentat
 
 vector<Declaration const*> const& ContractDefinition::inheritableMembers() const
 {
+	lock_guard<recursive_mutex> lock(m_cacheMutex);
 	if (!m_inheritableMembers)
 	{
 		set<string> memberSeen;
@@ -248,55 +346,47 @@ vector<Declaration const*> const& ContractDefinition::inheritableMembers() const
 
 TypePointer ContractDefinition::type() const
 {
-	return make_shared<TypeType>(make_shared<ContractType>(*this));
+	return TypeProvider::typeType(*this);
 }
 
 ContractDefinitionAnnotation& ContractDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ContractDefinitionAnnotation();
-	return static_cast<ContractDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<ContractDefinitionAnnotation>();
 }
 
 TypeNameAnnotation& TypeName::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new TypeNameAnnotation();
-	return static_cast<TypeNameAnnotation&>(*m_annotation);
+	return initAnnotation<TypeNameAnnotation>();
 }
 
 TypePointer StructDefinition::type() const
 {
-	return make_shared<TypeType>(make_shared<StructType>(*this));
+	return TypeProvider::typeType(*this);
 }
 
 TypeDeclarationAnnotation& StructDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new TypeDeclarationAnnotation();
-	return static_cast<TypeDeclarationAnnotation&>(*m_annotation);
+	return initAnnotation<TypeDeclarationAnnotation>();
 }
 
 TypePointer EnumValue::type() const
 {
 	auto parentDef = dynamic_cast<EnumDefinition const*>(scope());
 	solAssert(parentDef, "Enclosing Scope of EnumValue was not set");
-	return make_shared<EnumType>(*parentDef);
+	return TypeProvider::enumType(*parentDef);
 }
 
 TypePointer EnumDefinition::type() const
 {
-	return make_shared<TypeType>(make_shared<EnumType>(*this));
+	return TypeProvider::typeType(*this);
 }
 
 TypeDeclarationAnnotation& EnumDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new TypeDeclarationAnnotation();
-	return static_cast<TypeDeclarationAnnotation&>(*m_annotation);
+	return initAnnotation<TypeDeclarationAnnotation>();
 }
 
-shared_ptr<FunctionType> FunctionDefinition::functionType(bool _internal) const
+FunctionTypePointer FunctionDefinition::functionType(bool _internal) const
 {
 	if (_internal)
 	{
@@ -307,7 +397,7 @@ shared_ptr<FunctionType> FunctionDefinition::functionType(bool _internal) const
 		case Declaration::Visibility::Private:
 		case Declaration::Visibility::Internal:
 		case Declaration::Visibility::Public:
-			return make_shared<FunctionType>(*this, _internal);
+			return TypeProvider::function(*this, _internal);
 		case Declaration::Visibility::External:
 			return {};
 		default:
@@ -325,7 +415,7 @@ shared_ptr<FunctionType> FunctionDefinition::functionType(bool _internal) const
 			return {};
 		case Declaration::Visibility::Public:
 		case Declaration::Visibility::External:
-			return make_shared<FunctionType>(*this, _internal);
+			return TypeProvider::function(*this, _internal);
 		default:
 			solAssert(false, "visibility() should not return a Visibility");
 		}
@@ -337,7 +427,7 @@ shared_ptr<FunctionType> FunctionDefinition::functionType(bool _internal) const
 
 TypePointer FunctionDefinition::type() const
 {
-	return make_shared<FunctionType>(*this);
+	return TypeProvider::function(*this);
 }
 
 string FunctionDefinition::externalSignature() const
@@ -347,9 +437,7 @@ string FunctionDefinition::externalSignature() const
 
 FunctionDefinitionAnnotation& FunctionDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new FunctionDefinitionAnnotation();
-	return static_cast<FunctionDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<FunctionDefinitionAnnotation>();
 }
 
 TypePointer ModifierDefinition::type() const
@@ -359,9 +447,7 @@ TypePointer ModifierDefinition::type() const
 
 ModifierDefinitionAnnotation& ModifierDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ModifierDefinitionAnnotation();
-	return static_cast<ModifierDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<ModifierDefinitionAnnotation>();
 }
 
 TypePointer EventDefinition::type() const
@@ -369,7 +455,7 @@ TypePointer EventDefinition::type() const
 	return make_shared<FunctionType>(*this);
 }
 
-std::shared_ptr<FunctionType> EventDefinition::functionType(bool _internal) const
+FunctionTypePointer EventDefinition::functionType(bool _internal) const
 {
 	if (_internal)
 		return make_shared<FunctionType>(*this);
@@ -379,16 +465,12 @@ std::shared_ptr<FunctionType> EventDefinition::functionType(bool _internal) cons
 
 EventDefinitionAnnotation& EventDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new EventDefinitionAnnotation();
-	return static_cast<EventDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<EventDefinitionAnnotation>();
 }
 
 UserDefinedTypeNameAnnotation& UserDefinedTypeName::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new UserDefinedTypeNameAnnotation();
-	return static_cast<UserDefinedTypeNameAnnotation&>(*m_annotation);
+	return initAnnotation<UserDefinedTypeNameAnnotation>();
 }
 
 bool VariableDeclaration::isLValue() const
@@ -434,7 +516,7 @@ TypePointer VariableDeclaration::type() const
 	return annotation().type;
 }
 
-shared_ptr<FunctionType> VariableDeclaration::functionType(bool _internal) const
+FunctionTypePointer VariableDeclaration::functionType(bool _internal) const
 {
 	if (_internal)
 		return {};
@@ -458,72 +540,52 @@ shared_ptr<FunctionType> VariableDeclaration::functionType(bool _internal) const
 
 VariableDeclarationAnnotation& VariableDeclaration::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new VariableDeclarationAnnotation();
-	return static_cast<VariableDeclarationAnnotation&>(*m_annotation);
+	return initAnnotation<VariableDeclarationAnnotation>();
 }
 
 StatementAnnotation& Statement::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new StatementAnnotation();
-	return static_cast<StatementAnnotation&>(*m_annotation);
+	return initAnnotation<StatementAnnotation>();
 }
 
 InlineAssemblyAnnotation& InlineAssembly::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new InlineAssemblyAnnotation();
-	return static_cast<InlineAssemblyAnnotation&>(*m_annotation);
+	return initAnnotation<InlineAssemblyAnnotation>();
 }
 
 ReturnAnnotation& Return::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ReturnAnnotation();
-	return static_cast<ReturnAnnotation&>(*m_annotation);
+	return initAnnotation<ReturnAnnotation>();
 }
 
 VariableDeclarationStatementAnnotation& VariableDeclarationStatement::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new VariableDeclarationStatementAnnotation();
-	return static_cast<VariableDeclarationStatementAnnotation&>(*m_annotation);
+	return initAnnotation<VariableDeclarationStatementAnnotation>();
 }
 
 ExpressionAnnotation& Expression::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ExpressionAnnotation();
-	return static_cast<ExpressionAnnotation&>(*m_annotation);
+	return initAnnotation<ExpressionAnnotation>();
 }
 
 MemberAccessAnnotation& MemberAccess::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new MemberAccessAnnotation();
-	return static_cast<MemberAccessAnnotation&>(*m_annotation);
+	return initAnnotation<MemberAccessAnnotation>();
 }
 
 BinaryOperationAnnotation& BinaryOperation::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new BinaryOperationAnnotation();
-	return static_cast<BinaryOperationAnnotation&>(*m_annotation);
+	return initAnnotation<BinaryOperationAnnotation>();
 }
 
 FunctionCallAnnotation& FunctionCall::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new FunctionCallAnnotation();
-	return static_cast<FunctionCallAnnotation&>(*m_annotation);
+	return initAnnotation<FunctionCallAnnotation>();
 }
 
 IdentifierAnnotation& Identifier::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new IdentifierAnnotation();
-	return static_cast<IdentifierAnnotation&>(*m_annotation);
+	return initAnnotation<IdentifierAnnotation>();
 }
 
 bool Literal::looksLikeAddress() const
@@ -23,9 +23,12 @@
 #pragma once
 
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <boost/noncopyable.hpp>
 #include <libevmasm/SourceLocation.h>
 #include <libevmasm/Instruction.h>
@@ -59,8 +62,11 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
-	static void resetID();
+	/// Resets the ID counter of the current thread, such that the next node created on this
+	/// thread receives the ID @a _lastID + 1. This invalidates all previous IDs.
+	static void resetID(size_t _lastID = 0);
+	/// @returns the ID of the node that was last created on the current thread.
+	static size_t lastID();
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -99,11 +105,32 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	/// Removes the annotation and any other data that was added during analysis.
+	virtual void clearAnalysisData();
+
+	/// @returns the annotation, creating it as an instance of @a T if it does not exist yet.
+	/// Contracts are analysed concurrently and may request annotations of each other's
+	/// nodes, so the annotation is only ever installed once.
+	template <class T>
+	T& initAnnotation() const
+	{
+		if (!m_annotation)
+		{
+			ASTAnnotation* expected = nullptr;
+			ASTAnnotation* annotation = new T();
+			if (!m_annotation.compare_exchange_strong(expected, annotation))
+				delete annotation;
+		}
+		return static_cast<T&>(*m_annotation.load());
+	}
+
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
-	mutable ASTAnnotation* m_annotation = nullptr;
+	mutable std::atomic<ASTAnnotation*> m_annotation{nullptr};
 
 private:
+	friend class SourceUnit;
+
 	SourceLocation m_location;
 };
 
@@ -132,6 +159,13 @@ public:
 
 	std::vector<ASTPointer<ASTNode>> nodes() const { return m_nodes; }
 
+	/// Adds @a _offset to the IDs of this node and all nodes below it. Used to number the
+	/// nodes of sources that were parsed on different threads as if they were parsed in sequence.
+	void shiftIDs(size_t _offset);
+	/// Removes the annotations of this node and all nodes below it, such that the
+	/// source unit can be analysed again.
+	void clearAnnotations();
+
 private:
 	std::vector<ASTPointer<ASTNode>> m_nodes;
 };
@@ -180,7 +214,7 @@ public:
 
 	/// @param _internal false indicates external interface is concerned, true indicates internal interface is concerned.
 	/// @returns null when it is not accessible as a function.
-	virtual std::shared_ptr<FunctionType> functionType(bool /*_internal*/) const { return {}; }
+	virtual FunctionTypePointer functionType(bool /*_internal*/) const { return {}; }
 
 protected:
 	virtual Visibility defaultVisibility() const { return Visibility::Public; }
@@ -316,6 +350,11 @@ protected:
 class ContractDefinition: public Declaration, public Documented
 {
 public:
+	/// Functions (except constructors) that override each other, i.e. that have the same name
+	/// and parameter types. They are ordered like the linearized base contracts, so the first
+	/// function is the final override.
+	using OverrideChain = std::vector<FunctionDefinition const*>;
+
 	ContractDefinition(
 		SourceLocation const& _location,
 		ASTPointer<ASTString> const& _name,
@@ -351,6 +390,11 @@ public:
 	std::map<FixedHash<4>, FunctionTypePointer> interfaceFunctions() const;
 	std::vector<std::pair<FixedHash<4>, FunctionTypePointer>> const& interfaceFunctionList() const;
 
+	/// @returns the chain of functions that override or are overridden by @a _function, which has
+	/// to be a function (but not the constructor) of this contract or one of its bases.
+	/// The chains are computed once for all functions, this requires the parameter types to be resolved.
+	OverrideChain const& overrideChain(FunctionDefinition const& _function) const;
+
 	/// @returns a list of the inheritable members of this contract
 	std::vector<Declaration const*> const& inheritableMembers() const;
 
@@ -369,6 +413,9 @@ public:
 
 	virtual ContractDefinitionAnnotation& annotation() const override;
 
+protected:
+	virtual void clearAnalysisData() override;
+
 private:
 	std::vector<ASTPointer<InheritanceSpecifier>> m_baseContracts;
 	std::vector<ASTPointer<ASTNode>> m_subNodes;
@@ -380,8 +427,12 @@ private:
 
 	std::vector<ContractDefinition const*> m_linearizedBaseContracts;
 	mutable std::unique_ptr<std::vector<std::pair<FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList;
+	/// Override chains indexed by each of their functions.
+	mutable std::unique_ptr<std::unordered_map<FunctionDefinition const*, std::shared_ptr<OverrideChain>>> m_overrideChains;
 	mutable std::unique_ptr<std::vector<EventDefinition const*>> m_interfaceEvents;
 	mutable std::unique_ptr<std::vector<Declaration const*>> m_inheritableMembers;
+	/// Guards the lazily computed members above, contracts are type checked concurrently.
+	mutable std::recursive_mutex m_cacheMutex;
 };
 
 class InheritanceSpecifier: public ASTNode
@@ -594,7 +645,7 @@ public:
 
 	/// @param _internal false indicates external interface is concerned, true indicates internal interface is concerned.
 	/// @returns null when it is not accessible as a function.
-	virtual std::shared_ptr<FunctionType> functionType(bool /*_internal*/) const override;
+	virtual FunctionTypePointer functionType(bool /*_internal*/) const override;
 
 	virtual FunctionDefinitionAnnotation& annotation() const override;
 
@@ -660,7 +711,7 @@ public:
 
 	/// @param _internal false indicates external interface is concerned, true indicates internal interface is concerned.
 	/// @returns null when it is not accessible as a function.
-	virtual std::shared_ptr<FunctionType> functionType(bool /*_internal*/) const override;
+	virtual FunctionTypePointer functionType(bool /*_internal*/) const override;
 
 	virtual VariableDeclarationAnnotation& annotation() const override;
 
@@ -759,7 +810,7 @@ public:
 	bool isAnonymous() const { return m_anonymous; }
 
 	virtual TypePointer type() const override;
-	virtual std::shared_ptr<FunctionType> functionType(bool /*_internal*/) const override;
+	virtual FunctionTypePointer functionType(bool /*_internal*/) const override;
 
 	virtual EventDefinitionAnnotation& annotation() const override;
 
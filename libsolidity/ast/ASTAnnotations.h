@@ -27,6 +27,7 @@
 #include <vector>
 #include <set>
 #include <libsolidity/ast/ASTForward.h>
+#include <libdevcore/FixedHash.h>
 
 namespace dev
 {
@@ -54,6 +55,19 @@ struct DocumentedAnnotation
 	std::multimap<std::string, DocTag> docTags;
 };
 
+/// Annotation of declarations that can be part of the external interface of a contract, i.e.
+/// functions, state variables and events.
+struct ExternalSignatureAnnotation
+{
+	virtual ~ExternalSignatureAnnotation() {}
+	/// The external signature (name and canonical parameter types), set by the type checker
+	/// if the declaration has one.
+	std::string externalSignature;
+	/// Keccak-256 hash of the external signature. Its first four bytes are the function selector,
+	/// for events it is the topic.
+	h256 externalSignatureHash;
+};
+
 struct SourceUnitAnnotation: ASTAnnotation
 {
 	/// The "absolute" (in the compiler sense) path of this source unit.
@@ -90,11 +104,11 @@ struct ContractDefinitionAnnotation: TypeDeclarationAnnotation, DocumentedAnnota
 	std::set<ContractDefinition const*> contractDependencies;
 };
 
-struct FunctionDefinitionAnnotation: ASTAnnotation, DocumentedAnnotation
+struct FunctionDefinitionAnnotation: ASTAnnotation, DocumentedAnnotation, ExternalSignatureAnnotation
 {
 };
 
-struct EventDefinitionAnnotation: ASTAnnotation, DocumentedAnnotation
+struct EventDefinitionAnnotation: ASTAnnotation, DocumentedAnnotation, ExternalSignatureAnnotation
 {
 };
 
@@ -102,7 +116,7 @@ struct ModifierDefinitionAnnotation: ASTAnnotation, DocumentedAnnotation
 {
 };
 
-struct VariableDeclarationAnnotation: ASTAnnotation
+struct VariableDeclarationAnnotation: ASTAnnotation, ExternalSignatureAnnotation
 {
 	/// Type of variable (type of identifier referencing this variable).
 	TypePointer type;
@@ -0,0 +1,51 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Bump allocator for AST nodes and strings.
+ */
+
+#include <libsolidity/ast/ASTArena.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+size_t const ASTArena::defaultChunkSize = 64 * 1024;
+
+void* ASTArena::allocate(size_t _size, size_t _alignment)
+{
+	size_t padding = m_current ? (_alignment - reinterpret_cast<uintptr_t>(m_current) % _alignment) % _alignment : 0;
+	if (!m_current || padding + _size > m_remaining)
+	{
+		// Chunks are allocated with the alignment of operator new, which is sufficient for all
+		// AST objects. Objects that do not fit into a regular chunk get a chunk of their own.
+		size_t chunkSize = max(m_chunkSize, _size);
+		m_chunks.emplace_back(new char[chunkSize]);
+		m_reservedBytes += chunkSize;
+		if (chunkSize > m_chunkSize && m_current)
+			// Keep using the current chunk for the following small objects.
+			return m_chunks.back().get();
+		m_current = m_chunks.back().get();
+		m_remaining = chunkSize;
+		padding = 0;
+	}
+	char* ret = m_current + padding;
+	m_current += padding + _size;
+	m_remaining -= padding + _size;
+	return ret;
+}
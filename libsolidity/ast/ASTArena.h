@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Bump allocator for AST nodes and strings.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <libsolidity/ast/ASTForward.h>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Memory area that AST nodes (including their reference counts) and strings created during
+ * parsing are allocated from. Allocation only bumps a pointer inside a large chunk, individual
+ * objects are never freed and the chunks are released together once the last object is gone.
+ * The destructors of the objects still run when they are released.
+ * Allocation is not thread-safe, so each parser run uses its own arena.
+ */
+class ASTArena: private boost::noncopyable
+{
+public:
+	static size_t const defaultChunkSize;
+
+	explicit ASTArena(size_t _chunkSize = defaultChunkSize): m_chunkSize(_chunkSize) {}
+
+	/// @returns a pointer to @a _size bytes of uninitialised memory aligned to @a _alignment.
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the total number of bytes reserved for chunks.
+	size_t reservedBytes() const { return m_reservedBytes; }
+
+private:
+	size_t const m_chunkSize;
+	std::vector<std::unique_ptr<char[]>> m_chunks;
+	char* m_current = nullptr;
+	size_t m_remaining = 0;
+	size_t m_reservedBytes = 0;
+};
+
+/// Standard allocator adaptor for ASTArena. Every object keeps the arena alive, so it is safe
+/// to hold on to parts of an AST after the source unit has been released.
+template <class T>
+class ASTArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ASTArenaAllocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ASTArenaAllocator(ASTArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _n) { return static_cast<T*>(m_arena->allocate(_n * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) {}
+
+	std::shared_ptr<ASTArena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ASTArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ASTArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<ASTArena> m_arena;
+};
+
+/// Creates an object of type @a T inside @a _arena or on the heap if @a _arena is null.
+template <class T, class... Args>
+ASTPointer<T> makeArenaObject(std::shared_ptr<ASTArena> const& _arena, Args&&... _args)
+{
+	if (!_arena)
+		return std::make_shared<T>(std::forward<Args>(_args)...);
+	return std::allocate_shared<T>(ASTArenaAllocator<T>(_arena), std::forward<Args>(_args)...);
+}
+
+}
+}
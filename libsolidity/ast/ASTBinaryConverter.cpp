@@ -0,0 +1,585 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Converts the AST into a compact binary format and reads it back.
+ */
+
+#include <libsolidity/ast/ASTBinaryConverter.h>
+#include <boost/algorithm/string/join.hpp>
+#include <libsolidity/interface/Exceptions.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+unsigned const c_version = 1;
+size_t const c_flushSize = 0x10000;
+
+enum ValueTag: byte
+{
+	NullTag,
+	FalseTag,
+	TrueTag,
+	UIntTag,
+	StringTag,
+	ArrayTag
+};
+
+string visibility(Declaration::Visibility _visibility)
+{
+	switch (_visibility)
+	{
+	case Declaration::Visibility::Private:
+		return "private";
+	case Declaration::Visibility::Internal:
+		return "internal";
+	case Declaration::Visibility::Public:
+		return "public";
+	case Declaration::Visibility::External:
+		return "external";
+	default:
+		return "default";
+	}
+}
+
+Json::Value declarationID(Declaration const* _declaration)
+{
+	return _declaration ? Json::Value(Json::UInt64(_declaration->id())) : Json::Value();
+}
+
+}
+
+ASTBinaryConverter::ASTBinaryConverter(ostream& _out, map<string, unsigned> _sourceIndices):
+	m_out(_out), m_sourceIndices(move(_sourceIndices))
+{
+}
+
+void ASTBinaryConverter::write(ASTNode const& _ast)
+{
+	m_buffer = bytes{'S', 'A', 'S', 'T', byte(c_version)};
+	m_strings.clear();
+	_ast.accept(*this);
+	flush(true);
+}
+
+void ASTBinaryConverter::writeNode(ASTNode const& _node, char const* _kind, Attributes const& _attributes)
+{
+	// The marker distinguishes a node from the end of the list of children.
+	m_buffer.push_back(1);
+	writeString(_kind);
+	writeVarint(_node.id());
+	SourceLocation const& location = _node.location();
+	int length = location.start >= 0 && location.end >= 0 ? location.end - location.start : -1;
+	int sourceIndex = -1;
+	if (location.sourceName && m_sourceIndices.count(*location.sourceName))
+		sourceIndex = m_sourceIndices.at(*location.sourceName);
+	writeVarint(size_t(location.start + 1));
+	writeVarint(size_t(length + 1));
+	writeVarint(size_t(sourceIndex + 1));
+	writeVarint(_attributes.size());
+	for (auto const& attribute: _attributes)
+	{
+		writeString(attribute.first);
+		writeValue(attribute.second);
+	}
+	flush();
+}
+
+void ASTBinaryConverter::writeExpression(Expression const& _node, char const* _kind, Attributes _attributes)
+{
+	TypePointer const& type = _node.annotation().type;
+	_attributes.emplace_back("type", type ? type->toString() : "Unknown");
+	_attributes.emplace_back("typeIdentifier", type ? Json::Value(type->identifier()) : Json::Value());
+	writeNode(_node, _kind, _attributes);
+}
+
+void ASTBinaryConverter::writeString(string const& _string)
+{
+	auto it = m_strings.find(_string);
+	if (it != m_strings.end())
+		writeVarint(it->second);
+	else
+	{
+		size_t index = m_strings.size();
+		m_strings[_string] = index;
+		writeVarint(index);
+		writeVarint(_string.size());
+		m_buffer.insert(m_buffer.end(), _string.begin(), _string.end());
+	}
+}
+
+void ASTBinaryConverter::writeValue(Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		m_buffer.push_back(NullTag);
+		break;
+	case Json::booleanValue:
+		m_buffer.push_back(_value.asBool() ? TrueTag : FalseTag);
+		break;
+	case Json::uintValue:
+	case Json::intValue:
+		solAssert(_value.isUInt64(), "Negative values are not supported.");
+		m_buffer.push_back(UIntTag);
+		writeVarint(_value.asUInt64());
+		break;
+	case Json::stringValue:
+		m_buffer.push_back(StringTag);
+		writeString(_value.asString());
+		break;
+	case Json::arrayValue:
+		m_buffer.push_back(ArrayTag);
+		writeVarint(_value.size());
+		for (auto const& element: _value)
+			writeValue(element);
+		break;
+	default:
+		solAssert(false, "Unsupported attribute value.");
+	}
+}
+
+void ASTBinaryConverter::flush(bool _force)
+{
+	if (_force || m_buffer.size() >= c_flushSize)
+	{
+		m_out.write(reinterpret_cast<char const*>(m_buffer.data()), m_buffer.size());
+		m_buffer.clear();
+	}
+}
+
+void ASTBinaryConverter::endVisitNode(ASTNode const&)
+{
+	m_buffer.push_back(0);
+}
+
+bool ASTBinaryConverter::visit(SourceUnit const& _node)
+{
+	writeNode(_node, "SourceUnit");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(PragmaDirective const& _node)
+{
+	Json::Value literals(Json::arrayValue);
+	for (auto const& literal: _node.literals())
+		literals.append(literal);
+	writeNode(_node, "PragmaDirective", {{"literals", literals}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ImportDirective const& _node)
+{
+	writeNode(_node, "ImportDirective", {
+		{"file", _node.path()},
+		{"absolutePath", _node.annotation().absolutePath}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ContractDefinition const& _node)
+{
+	Json::Value linearizedBaseContracts(Json::arrayValue);
+	for (auto const& baseContract: _node.annotation().linearizedBaseContracts)
+		linearizedBaseContracts.append(Json::UInt64(baseContract->id()));
+	writeNode(_node, "ContractDefinition", {
+		{"name", _node.name()},
+		{"isLibrary", _node.isLibrary()},
+		{"fullyImplemented", _node.annotation().isFullyImplemented},
+		{"linearizedBaseContracts", linearizedBaseContracts}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(InheritanceSpecifier const& _node)
+{
+	writeNode(_node, "InheritanceSpecifier");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(UsingForDirective const& _node)
+{
+	writeNode(_node, "UsingForDirective");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(StructDefinition const& _node)
+{
+	writeNode(_node, "StructDefinition", {{"name", _node.name()}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(EnumDefinition const& _node)
+{
+	writeNode(_node, "EnumDefinition", {{"name", _node.name()}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(EnumValue const& _node)
+{
+	writeNode(_node, "EnumValue", {{"name", _node.name()}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ParameterList const& _node)
+{
+	writeNode(_node, "ParameterList");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(FunctionDefinition const& _node)
+{
+	writeNode(_node, "FunctionDefinition", {
+		{"name", _node.name()},
+		{"constant", _node.isDeclaredConst()},
+		{"payable", _node.isPayable()},
+		{"visibility", visibility(_node.visibility())}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(VariableDeclaration const& _node)
+{
+	TypePointer const& type = _node.annotation().type;
+	writeNode(_node, "VariableDeclaration", {
+		{"name", _node.name()},
+		{"constant", _node.isConstant()},
+		{"visibility", visibility(_node.visibility())},
+		{"type", type ? type->toString() : "Unknown"},
+		{"typeIdentifier", type ? Json::Value(type->identifier()) : Json::Value()}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ModifierDefinition const& _node)
+{
+	writeNode(_node, "ModifierDefinition", {{"name", _node.name()}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ModifierInvocation const& _node)
+{
+	writeNode(_node, "ModifierInvocation");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(EventDefinition const& _node)
+{
+	writeNode(_node, "EventDefinition", {{"name", _node.name()}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ElementaryTypeName const& _node)
+{
+	writeNode(_node, "ElementaryTypeName", {{"name", _node.typeName().toString()}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(UserDefinedTypeName const& _node)
+{
+	writeNode(_node, "UserDefinedTypeName", {
+		{"name", boost::algorithm::join(_node.namePath(), ".")},
+		{"referencedDeclaration", declarationID(_node.annotation().referencedDeclaration)}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(FunctionTypeName const& _node)
+{
+	writeNode(_node, "FunctionTypeName", {
+		{"payable", _node.isPayable()},
+		{"visibility", visibility(_node.visibility())},
+		{"constant", _node.isDeclaredConst()}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Mapping const& _node)
+{
+	writeNode(_node, "Mapping");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ArrayTypeName const& _node)
+{
+	writeNode(_node, "ArrayTypeName");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(InlineAssembly const& _node)
+{
+	writeNode(_node, "InlineAssembly");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Block const& _node)
+{
+	writeNode(_node, "Block");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(PlaceholderStatement const& _node)
+{
+	writeNode(_node, "PlaceholderStatement");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(IfStatement const& _node)
+{
+	writeNode(_node, "IfStatement");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(WhileStatement const& _node)
+{
+	writeNode(_node, _node.isDoWhile() ? "DoWhileStatement" : "WhileStatement");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ForStatement const& _node)
+{
+	writeNode(_node, "ForStatement");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Continue const& _node)
+{
+	writeNode(_node, "Continue");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Break const& _node)
+{
+	writeNode(_node, "Break");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Return const& _node)
+{
+	writeNode(_node, "Return");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Throw const& _node)
+{
+	writeNode(_node, "Throw");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(VariableDeclarationStatement const& _node)
+{
+	writeNode(_node, "VariableDeclarationStatement");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ExpressionStatement const& _node)
+{
+	writeNode(_node, "ExpressionStatement");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Conditional const& _node)
+{
+	writeExpression(_node, "Conditional");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Assignment const& _node)
+{
+	writeExpression(_node, "Assignment", {{"operator", Token::toString(_node.assignmentOperator())}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(TupleExpression const& _node)
+{
+	writeExpression(_node, "TupleExpression");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(UnaryOperation const& _node)
+{
+	writeExpression(_node, "UnaryOperation", {
+		{"prefix", _node.isPrefixOperation()},
+		{"operator", Token::toString(_node.getOperator())}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(BinaryOperation const& _node)
+{
+	writeExpression(_node, "BinaryOperation", {{"operator", Token::toString(_node.getOperator())}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(FunctionCall const& _node)
+{
+	writeExpression(_node, "FunctionCall", {{"type_conversion", _node.annotation().isTypeConversion}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(NewExpression const& _node)
+{
+	writeExpression(_node, "NewExpression");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(MemberAccess const& _node)
+{
+	writeExpression(_node, "MemberAccess", {
+		{"member_name", _node.memberName()},
+		{"referencedDeclaration", declarationID(_node.annotation().referencedDeclaration)}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(IndexAccess const& _node)
+{
+	writeExpression(_node, "IndexAccess");
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Identifier const& _node)
+{
+	writeExpression(_node, "Identifier", {
+		{"value", _node.name()},
+		{"referencedDeclaration", declarationID(_node.annotation().referencedDeclaration)}
+	});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(ElementaryTypeNameExpression const& _node)
+{
+	writeExpression(_node, "ElementaryTypeNameExpression", {{"value", _node.typeName().toString()}});
+	return true;
+}
+
+bool ASTBinaryConverter::visit(Literal const& _node)
+{
+	char const* tokenString = Token::toString(_node.token());
+	Token::Value subdenomination = Token::Value(_node.subDenomination());
+	// The value is stored as is, the binary format does not require valid UTF-8.
+	writeExpression(_node, "Literal", {
+		{"token", tokenString ? tokenString : Json::Value()},
+		{"value", _node.value()},
+		{
+			"subdenomination",
+			subdenomination == Token::Illegal ? Json::Value() : Json::Value(Token::toString(subdenomination))
+		}
+	});
+	return true;
+}
+
+size_t const ASTBinaryReader::defaultMaxDepth = 4096;
+
+BinaryASTNode ASTBinaryReader::read()
+{
+	m_pos = 0;
+	m_strings.clear();
+	if (m_data.size() < 5 || m_data.cropped(0, 4).toString() != "SAST" || m_data[4] != c_version)
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid binary AST header."));
+	m_pos = 5;
+	if (readByte() != 1)
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid node marker."));
+	BinaryASTNode root;
+	readNode(root, 0);
+	return root;
+}
+
+void ASTBinaryReader::readNode(BinaryASTNode& o_node, size_t _depth)
+{
+	if (_depth > m_maxDepth)
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Binary AST nested too deeply."));
+	o_node.kind = readString();
+	o_node.id = readVarint();
+	o_node.start = int(readVarint()) - 1;
+	o_node.length = int(readVarint()) - 1;
+	o_node.sourceIndex = int(readVarint()) - 1;
+	for (size_t attributes = readVarint(); attributes > 0; --attributes)
+	{
+		string name = readString();
+		o_node.attributes[name] = readValue(_depth + 1);
+	}
+	while (byte marker = readByte())
+	{
+		if (marker != 1)
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid node marker."));
+		o_node.children.emplace_back();
+		readNode(o_node.children.back(), _depth + 1);
+	}
+}
+
+string ASTBinaryReader::readString()
+{
+	size_t index = readVarint();
+	if (index == m_strings.size())
+	{
+		size_t length = readVarint();
+		if (length > m_data.size() - m_pos)
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Truncated binary AST."));
+		m_strings.push_back(m_data.cropped(m_pos, length).toString());
+		m_pos += length;
+	}
+	else if (index > m_strings.size())
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid string index."));
+	return m_strings[index];
+}
+
+Json::Value ASTBinaryReader::readValue(size_t _depth)
+{
+	if (_depth > m_maxDepth)
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Binary AST nested too deeply."));
+	switch (readByte())
+	{
+	case NullTag:
+		return Json::Value();
+	case FalseTag:
+		return false;
+	case TrueTag:
+		return true;
+	case UIntTag:
+		return Json::UInt64(readVarint());
+	case StringTag:
+		return readString();
+	case ArrayTag:
+	{
+		Json::Value array(Json::arrayValue);
+		for (size_t elements = readVarint(); elements > 0; --elements)
+			array.append(readValue(_depth + 1));
+		return array;
+	}
+	default:
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid value tag."));
+	}
+}
+
+size_t ASTBinaryReader::readVarint()
+{
+	if (m_pos >= m_data.size())
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Truncated binary AST."));
+	return dev::readVarint<size_t>(m_data, m_pos);
+}
+
+byte ASTBinaryReader::readByte()
+{
+	if (m_pos >= m_data.size())
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Truncated binary AST."));
+	return m_data[m_pos++];
+}
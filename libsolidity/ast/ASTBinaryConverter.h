@@ -0,0 +1,179 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Converts the AST into a compact binary format and reads it back.
+ */
+
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Exceptions.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/AST.h>
+#include <json/json.h>
+
+namespace dev
+{
+namespace solidity
+{
+
+DEV_SIMPLE_EXCEPTION(InvalidBinaryAST);
+
+/**
+ * Writes the AST in a compact binary format directly to a stream, without building an
+ * intermediate tree. The format is
+ *   "SAST" version:byte node
+ *   node: 1 kind:string id:varint (start+1):varint (length+1):varint (sourceIndex+1):varint
+ *         attributeCount:varint (name:string value)* node* 0
+ * where all varints are unsigned LEB128. Strings are interned: a string is written as its
+ * index in the table of all previous strings, where the index equal to the size of the table
+ * is followed by the length and the bytes of a new string. Values start with a tag byte:
+ * 0 null, 1 false, 2 true, 3 unsigned integer (varint), 4 string, 5 array (count:varint value*).
+ * The attributes are those of the JSON AST, with type identifiers, the IDs of referenced
+ * declarations and the constness and visibility of variable declarations added. Literals store
+ * their value as is (also if it is not valid UTF-8) instead of an additional "hexvalue".
+ */
+class ASTBinaryConverter: public ASTConstVisitor
+{
+public:
+	/// @a _sourceIndices is used to abbreviate source names in source locations.
+	explicit ASTBinaryConverter(
+		std::ostream& _out,
+		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
+	);
+
+	/// Writes @a _ast to the stream.
+	void write(ASTNode const& _ast);
+
+	bool visit(SourceUnit const& _node) override;
+	bool visit(PragmaDirective const& _node) override;
+	bool visit(ImportDirective const& _node) override;
+	bool visit(ContractDefinition const& _node) override;
+	bool visit(InheritanceSpecifier const& _node) override;
+	bool visit(UsingForDirective const& _node) override;
+	bool visit(StructDefinition const& _node) override;
+	bool visit(EnumDefinition const& _node) override;
+	bool visit(EnumValue const& _node) override;
+	bool visit(ParameterList const& _node) override;
+	bool visit(FunctionDefinition const& _node) override;
+	bool visit(VariableDeclaration const& _node) override;
+	bool visit(ModifierDefinition const& _node) override;
+	bool visit(ModifierInvocation const& _node) override;
+	bool visit(EventDefinition const& _node) override;
+	bool visit(ElementaryTypeName const& _node) override;
+	bool visit(UserDefinedTypeName const& _node) override;
+	bool visit(FunctionTypeName const& _node) override;
+	bool visit(Mapping const& _node) override;
+	bool visit(ArrayTypeName const& _node) override;
+	bool visit(InlineAssembly const& _node) override;
+	bool visit(Block const& _node) override;
+	bool visit(PlaceholderStatement const& _node) override;
+	bool visit(IfStatement const& _node) override;
+	bool visit(WhileStatement const& _node) override;
+	bool visit(ForStatement const& _node) override;
+	bool visit(Continue const& _node) override;
+	bool visit(Break const& _node) override;
+	bool visit(Return const& _node) override;
+	bool visit(Throw const& _node) override;
+	bool visit(VariableDeclarationStatement const& _node) override;
+	bool visit(ExpressionStatement const& _node) override;
+	bool visit(Conditional const& _node) override;
+	bool visit(Assignment const& _node) override;
+	bool visit(TupleExpression const& _node) override;
+	bool visit(UnaryOperation const& _node) override;
+	bool visit(BinaryOperation const& _node) override;
+	bool visit(FunctionCall const& _node) override;
+	bool visit(NewExpression const& _node) override;
+	bool visit(MemberAccess const& _node) override;
+	bool visit(IndexAccess const& _node) override;
+	bool visit(Identifier const& _node) override;
+	bool visit(ElementaryTypeNameExpression const& _node) override;
+	bool visit(Literal const& _node) override;
+
+protected:
+	void endVisitNode(ASTNode const&) override;
+
+private:
+	using Attributes = std::vector<std::pair<char const*, Json::Value>>;
+
+	void writeNode(ASTNode const& _node, char const* _kind, Attributes const& _attributes = Attributes());
+	/// Writes an expression node, adding its type to @a _attributes.
+	void writeExpression(Expression const& _node, char const* _kind, Attributes _attributes = Attributes());
+	void writeString(std::string const& _string);
+	void writeValue(Json::Value const& _value);
+	void writeVarint(size_t _value) { appendVarint(_value, m_buffer); }
+	/// Writes the buffered data to the stream if it exceeds a certain size or @a _force is true.
+	void flush(bool _force = false);
+
+	std::ostream& m_out;
+	std::map<std::string, unsigned> m_sourceIndices;
+	bytes m_buffer;
+	std::unordered_map<std::string, size_t> m_strings;
+};
+
+/// Node of an AST read from the binary format.
+struct BinaryASTNode
+{
+	std::string kind;
+	size_t id = 0;
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	Json::Value attributes{Json::objectValue};
+	std::vector<BinaryASTNode> children;
+};
+
+/**
+ * Reader for ASTs written by ASTBinaryConverter.
+ */
+class ASTBinaryReader
+{
+public:
+	static size_t const defaultMaxDepth;
+
+	/// Creates a reader for @a _data, which has to outlive the reader. Nodes and values nested
+	/// deeper than @a _maxDepth are rejected, which bounds the recursion on malformed input.
+	explicit ASTBinaryReader(bytesConstRef _data, size_t _maxDepth = defaultMaxDepth):
+		m_data(_data), m_maxDepth(_maxDepth) {}
+
+	/// @returns the root node of the AST.
+	/// @throws InvalidBinaryAST if the data is malformed or nested too deeply.
+	BinaryASTNode read();
+
+private:
+	void readNode(BinaryASTNode& o_node, size_t _depth);
+	/// @returns a copy of the string, since reading further strings can reallocate the table.
+	std::string readString();
+	Json::Value readValue(size_t _depth);
+	size_t readVarint();
+	byte readByte();
+
+	bytesConstRef m_data;
+	size_t const m_maxDepth;
+	size_t m_pos = 0;
+	std::vector<std::string> m_strings;
+};
+
+}
+}
@@ -87,9 +87,8 @@ class Literal;
 
 class VariableScope;
 
-// Used as pointers to AST nodes, to be replaced by more clever pointers, e.g. pointers which do
-// not do reference counting but point to a special memory area that is completely released
-// explicitly.
+// Used as pointers to AST nodes. Nodes created by the parser may live in an ASTArena, which
+// they keep alive.
 template <class T>
 using ASTPointer = std::shared_ptr<T>;
 
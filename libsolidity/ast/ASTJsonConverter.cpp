@@ -22,6 +22,7 @@
 
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/replace.hpp>
 #include <libdevcore/UTF8.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/interface/Exceptions.h>
@@ -40,6 +41,44 @@ void ASTJsonConverter::addJsonNode(
 	bool _hasChildren = false
 )
 {
+	if (m_out)
+	{
+		// Written in the layout of the Json::Value stream operator, with the keys in the order
+		// in which Json::Value sorts them.
+		solAssert(!m_openNodes.empty(), "Uneven json nodes stack. Internal error.");
+		OpenNode& parent = m_openNodes.back();
+		string const indent = parent.indent + "\t\t";
+		string const memberIndent = "\n" + indent + "\t";
+		*m_out << (parent.hasChildren ? "," : "\n" + parent.indent + "\t[") << "\n" << indent << "{";
+		parent.hasChildren = true;
+		if (_attributes.size() != 0)
+		{
+			Json::Value attrs;
+			for (auto& e: _attributes)
+				attrs[e.first] = e.second;
+			ostringstream attributes;
+			attributes << attrs;
+			string text = attributes.str();
+			while (!text.empty() && text.back() == '\n')
+				text.pop_back();
+			boost::replace_all(text, "\n", memberIndent);
+			*m_out << memberIndent << "\"attributes\" : " << memberIndent << text << ",";
+		}
+		string tail =
+			memberIndent + "\"id\" : " + to_string(_node.id()) + "," +
+			memberIndent + "\"name\" : " + Json::valueToQuotedString(_nodeName.c_str()) + "," +
+			memberIndent + "\"src\" : " + Json::valueToQuotedString(sourceLocationToString(_node.location()).c_str()) +
+			"\n" + indent + "}";
+		if (_hasChildren)
+		{
+			*m_out << memberIndent << "\"children\" : ";
+			m_openNodes.push_back(OpenNode{indent, "," + tail, false});
+		}
+		else
+			*m_out << tail;
+		return;
+	}
+
 	Json::Value node;
 
 	node["id"] = Json::UInt64(_node.id());
@@ -88,6 +127,14 @@ void ASTJsonConverter::print(ostream& _stream)
 	_stream << m_astJson;
 }
 
+void ASTJsonConverter::stream(ostream& _stream)
+{
+	m_out = &_stream;
+	m_ast->accept(*this);
+	m_out = nullptr;
+	solAssert(m_openNodes.empty(), "Uneven json nodes stack. Internal error.");
+}
+
 Json::Value const& ASTJsonConverter::json()
 {
 	process();
@@ -96,6 +143,13 @@ Json::Value const& ASTJsonConverter::json()
 
 bool ASTJsonConverter::visit(SourceUnit const&)
 {
+	if (m_out)
+	{
+		*m_out << "{\n\t\"children\" : ";
+		m_openNodes.push_back(OpenNode{"", ",\n\t\"name\" : \"SourceUnit\"\n}", false});
+		return true;
+	}
+
 	Json::Value children(Json::arrayValue);
 
 	m_astJson["name"] = "SourceUnit";
@@ -646,6 +700,20 @@ void ASTJsonConverter::endVisit(Literal const&)
 {
 }
 
+void ASTJsonConverter::goUp()
+{
+	if (m_out)
+	{
+		solAssert(!m_openNodes.empty(), "Uneven json nodes stack. Internal error.");
+		OpenNode const& node = m_openNodes.back();
+		*m_out << (node.hasChildren ? "\n" + node.indent + "\t]" : "[]") << node.tail;
+		m_openNodes.pop_back();
+		return;
+	}
+	solAssert(!m_jsonNodePtrs.empty(), "Uneven json nodes stack. Internal error.");
+	m_jsonNodePtrs.pop();
+}
+
 void ASTJsonConverter::process()
 {
 	if (!processed)
@@ -24,6 +24,7 @@
 
 #include <ostream>
 #include <stack>
+#include <vector>
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/Utils.h>
@@ -49,6 +50,9 @@ public:
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream);
+	/// Writes the same text as @a print to @a _stream while visiting the nodes, without
+	/// building the json tree. Memory usage only depends on the depth of the AST.
+	void stream(std::ostream& _stream);
 	Json::Value const& json();
 
 	bool visit(SourceUnit const& _node) override;
@@ -155,15 +159,24 @@ private:
 	std::string visibility(Declaration::Visibility const& _visibility);
 	std::string type(Expression const& _expression);
 	std::string type(VariableDeclaration const& _varDecl);
-	inline void goUp()
-	{
-		solAssert(!m_jsonNodePtrs.empty(), "Uneven json nodes stack. Internal error.");
-		m_jsonNodePtrs.pop();
-	}
+	void goUp();
 
 	bool processed = false;
 	Json::Value m_astJson;
 	std::stack<Json::Value*> m_jsonNodePtrs;
+	/// Node whose children are currently streamed.
+	struct OpenNode
+	{
+		/// Indentation of the node's braces.
+		std::string indent;
+		/// Text that follows the list of children and closes the node.
+		std::string tail;
+		/// Whether a child of the node has already been written.
+		bool hasChildren;
+	};
+	/// Output stream while streaming, nullptr otherwise.
+	std::ostream* m_out = nullptr;
+	std::vector<OpenNode> m_openNodes;
 	ASTNode const* m_ast;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
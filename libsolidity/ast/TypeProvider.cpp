@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Interned instances of the elementary types and of the types of declarations.
+ */
+
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/ast/AST.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+thread_local TypeProvider* s_currentProvider = nullptr;
+}
+
+TypeProvider::Scope::Scope(TypeProvider& _provider):
+	m_previous(s_currentProvider)
+{
+	s_currentProvider = &_provider;
+}
+
+TypeProvider::Scope::~Scope()
+{
+	s_currentProvider = m_previous;
+}
+
+TypeProvider::TypeProvider()
+{
+	for (auto modifier: {IntegerType::Modifier::Unsigned, IntegerType::Modifier::Signed})
+		for (int bytes = 1; bytes <= 32; ++bytes)
+			m_integers.push_back(make_shared<IntegerType>(bytes * 8, modifier));
+	m_address = make_shared<IntegerType>(160, IntegerType::Modifier::Address);
+	for (int bytes = 0; bytes <= 32; ++bytes)
+		m_fixedBytes.push_back(make_shared<FixedBytesType>(bytes));
+	m_boolean = make_shared<BoolType>();
+}
+
+TypeProvider* TypeProvider::current()
+{
+	return s_currentProvider;
+}
+
+TypeProvider& TypeProvider::get()
+{
+	solAssert(s_currentProvider, "Types have to be created while a type provider is in scope.");
+	return *s_currentProvider;
+}
+
+template <class T, class Key, class Create>
+T const& TypeProvider::intern(map<Key, T>& _types, Key const& _key, Create const& _create)
+{
+	{
+		lock_guard<mutex> lock(m_declarationTypesMutex);
+		auto it = _types.find(_key);
+		if (it != _types.end())
+			return it->second;
+	}
+	// Creating a type can request other types, so this is done without holding the lock.
+	// If another thread was faster, its type is kept.
+	T type = _create();
+	lock_guard<mutex> lock(m_declarationTypesMutex);
+	return _types.emplace(_key, move(type)).first->second;
+}
+
+shared_ptr<IntegerType const> TypeProvider::integer(int _bits, IntegerType::Modifier _modifier)
+{
+	TypeProvider& provider = get();
+	if (_modifier == IntegerType::Modifier::Address)
+		return provider.m_address;
+	if (_bits > 0 && _bits <= 256 && _bits % 8 == 0)
+		return provider.m_integers[(_modifier == IntegerType::Modifier::Signed ? 32 : 0) + _bits / 8 - 1];
+	return make_shared<IntegerType>(_bits, _modifier);
+}
+
+shared_ptr<FixedBytesType const> TypeProvider::fixedBytes(int _bytes)
+{
+	TypeProvider& provider = get();
+	if (_bytes >= 0 && _bytes <= 32)
+		return provider.m_fixedBytes[_bytes];
+	return make_shared<FixedBytesType>(_bytes);
+}
+
+shared_ptr<FixedPointType const> TypeProvider::fixedPoint(
+	int _integerBits,
+	int _fractionalBits,
+	FixedPointType::Modifier _modifier
+)
+{
+	TypeProvider& provider = get();
+	lock_guard<mutex> lock(provider.m_fixedPointMutex);
+	auto& type = provider.m_fixedPoints[make_tuple(_integerBits, _fractionalBits, _modifier)];
+	if (!type)
+		type = make_shared<FixedPointType>(_integerBits, _fractionalBits, _modifier);
+	return type;
+}
+
+shared_ptr<BoolType const> TypeProvider::boolean()
+{
+	return get().m_boolean;
+}
+
+shared_ptr<ContractType const> TypeProvider::contract(ContractDefinition const& _contract, bool _super)
+{
+	TypeProvider& provider = get();
+	return provider.intern(provider.m_contracts, make_pair(&_contract, _super), [&]()
+	{
+		return make_shared<ContractType const>(_contract, _super);
+	});
+}
+
+shared_ptr<StructType const> TypeProvider::structType(StructDefinition const& _struct)
+{
+	TypeProvider& provider = get();
+	return provider.intern(provider.m_structs, &_struct, [&]()
+	{
+		return make_shared<StructType const>(_struct);
+	});
+}
+
+shared_ptr<EnumType const> TypeProvider::enumType(EnumDefinition const& _enum)
+{
+	TypeProvider& provider = get();
+	return provider.intern(provider.m_enums, &_enum, [&]()
+	{
+		return make_shared<EnumType const>(_enum);
+	});
+}
+
+shared_ptr<FunctionType const> TypeProvider::function(FunctionDefinition const& _function, bool _isInternal)
+{
+	// The function type stores the types of the parameters, it can only be shared once they
+	// are resolved.
+	for (auto const* parameters: {&_function.parameters(), &_function.returnParameters()})
+		for (ASTPointer<VariableDeclaration> const& parameter: *parameters)
+			if (!parameter->annotation().type)
+				return make_shared<FunctionType const>(_function, _isInternal);
+	TypeProvider& provider = get();
+	return provider.intern(provider.m_functions, make_pair(&_function, _isInternal), [&]()
+	{
+		return make_shared<FunctionType const>(_function, _isInternal);
+	});
+}
+
+shared_ptr<TypeType const> TypeProvider::typeType(ContractDefinition const& _contract)
+{
+	TypeProvider& provider = get();
+	return provider.intern(provider.m_typeTypes, static_cast<Declaration const*>(&_contract), [&]()
+	{
+		return make_shared<TypeType const>(contract(_contract));
+	});
+}
+
+shared_ptr<TypeType const> TypeProvider::typeType(StructDefinition const& _struct)
+{
+	TypeProvider& provider = get();
+	return provider.intern(provider.m_typeTypes, static_cast<Declaration const*>(&_struct), [&]()
+	{
+		return make_shared<TypeType const>(structType(_struct));
+	});
+}
+
+shared_ptr<TypeType const> TypeProvider::typeType(EnumDefinition const& _enum)
+{
+	TypeProvider& provider = get();
+	return provider.intern(provider.m_typeTypes, static_cast<Declaration const*>(&_enum), [&]()
+	{
+		return make_shared<TypeType const>(enumType(_enum));
+	});
+}
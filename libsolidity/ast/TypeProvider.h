@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Interned instances of the elementary types and of the types of declarations.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/Types.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Provides a single shared instance for each of the elementary value types (integers,
+ * addresses, fixed bytes, fixed point numbers and bool) and for the types of contract, struct,
+ * enum and function definitions, so that equal types can be compared by pointer and their
+ * member lists are only computed once.
+ * A provider belongs to a single compilation, since member lists are cached per contract
+ * scope and the types of declarations are keyed by the declaration. The static accessors use
+ * the provider that is current in the calling thread (see @a Scope), there has to be one.
+ */
+class TypeProvider: private boost::noncopyable
+{
+public:
+	/// Makes a provider the current one of the calling thread for its lifetime.
+	class Scope: private boost::noncopyable
+	{
+	public:
+		explicit Scope(TypeProvider& _provider);
+		~Scope();
+
+	private:
+		TypeProvider* m_previous;
+	};
+
+	TypeProvider();
+
+	/// @returns the provider that is current in the calling thread or nullptr.
+	static TypeProvider* current();
+
+	static std::shared_ptr<IntegerType const> integer(int _bits, IntegerType::Modifier _modifier = IntegerType::Modifier::Unsigned);
+	static std::shared_ptr<IntegerType const> uint256() { return integer(256); }
+	static std::shared_ptr<IntegerType const> address() { return integer(160, IntegerType::Modifier::Address); }
+	static std::shared_ptr<FixedBytesType const> fixedBytes(int _bytes);
+	static std::shared_ptr<FixedPointType const> fixedPoint(
+		int _integerBits,
+		int _fractionalBits,
+		FixedPointType::Modifier _modifier = FixedPointType::Modifier::Unsigned
+	);
+	static std::shared_ptr<BoolType const> boolean();
+
+	static std::shared_ptr<ContractType const> contract(ContractDefinition const& _contract, bool _super = false);
+	/// @returns the type of a storage reference to @a _struct.
+	static std::shared_ptr<StructType const> structType(StructDefinition const& _struct);
+	static std::shared_ptr<EnumType const> enumType(EnumDefinition const& _enum);
+	static std::shared_ptr<FunctionType const> function(FunctionDefinition const& _function, bool _isInternal = true);
+	/// @returns the type of the type name @a _contract, @a _struct or @a _enum refers to.
+	static std::shared_ptr<TypeType const> typeType(ContractDefinition const& _contract);
+	static std::shared_ptr<TypeType const> typeType(StructDefinition const& _struct);
+	static std::shared_ptr<TypeType const> typeType(EnumDefinition const& _enum);
+
+private:
+	/// @returns the provider that is current in the calling thread and asserts that there is one.
+	static TypeProvider& get();
+	/// @returns the type stored for @a _key in @a _types, creating it with @a _create if needed.
+	template <class T, class Key, class Create>
+	T const& intern(std::map<Key, T>& _types, Key const& _key, Create const& _create);
+
+	/// Integer types indexed by the number of bytes minus one, signed types follow the
+	/// unsigned ones.
+	std::vector<std::shared_ptr<IntegerType const>> m_integers;
+	std::shared_ptr<IntegerType const> m_address;
+	/// Fixed bytes types indexed by the number of bytes.
+	std::vector<std::shared_ptr<FixedBytesType const>> m_fixedBytes;
+	std::shared_ptr<BoolType const> m_boolean;
+	/// Fixed point types are created on demand, since there are too many of them.
+	std::mutex m_fixedPointMutex;
+	std::map<std::tuple<int, int, FixedPointType::Modifier>, std::shared_ptr<FixedPointType const>> m_fixedPoints;
+	/// Types of declarations, created on demand and keyed by the declaration.
+	std::mutex m_declarationTypesMutex;
+	std::map<std::pair<ContractDefinition const*, bool>, std::shared_ptr<ContractType const>> m_contracts;
+	std::map<StructDefinition const*, std::shared_ptr<StructType const>> m_structs;
+	std::map<EnumDefinition const*, std::shared_ptr<EnumType const>> m_enums;
+	std::map<std::pair<FunctionDefinition const*, bool>, std::shared_ptr<FunctionType const>> m_functions;
+	std::map<Declaration const*, std::shared_ptr<TypeType const>> m_typeTypes;
+};
+
+}
+}
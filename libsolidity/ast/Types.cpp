@@ -21,6 +21,7 @@
  */
 
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libsolidity/interface/Utils.h>
 #include <libsolidity/ast/AST.h>
@@ -78,6 +79,66 @@ void StorageOffsets::computeOffsets(TypePointers const& _types)
 	swap(m_offsets, offsets);
 }
 
+void StorageOffsets::computePackedOffsets(vector<TypePointers> const& _segments)
+{
+	bigint nextSlot = 0;
+	// Slots that still have space left, together with the number of bytes already used.
+	vector<pair<bigint, unsigned>> partialSlots;
+	map<size_t, pair<u256, unsigned>> offsets;
+	auto checkSize = [](bigint const& _slot)
+	{
+		if (_slot >= bigint(1) << 256)
+			BOOST_THROW_EXCEPTION(Error(Error::Type::TypeError) << errinfo_comment("Object too large for storage."));
+	};
+	size_t segmentStart = 0;
+	for (TypePointers const& types: _segments)
+	{
+		vector<size_t> packable;
+		vector<size_t> fullSlots;
+		for (size_t i = 0; i < types.size(); ++i)
+			if (types[i]->canBeStored())
+			{
+				solAssert(types[i]->storageSize() >= 1, "Invalid storage size.");
+				if (types[i]->storageSize() == 1 && types[i]->storageBytes() < 32)
+					packable.push_back(i);
+				else
+					fullSlots.push_back(i);
+			}
+		stable_sort(packable.begin(), packable.end(), [&](size_t _a, size_t _b)
+		{
+			return types[_a]->storageBytes() > types[_b]->storageBytes();
+		});
+		for (size_t i: packable)
+		{
+			unsigned bytes = types[i]->storageBytes();
+			auto slot = find_if(partialSlots.begin(), partialSlots.end(), [&](pair<bigint, unsigned> const& _slot)
+			{
+				return _slot.second + bytes <= 32;
+			});
+			if (slot == partialSlots.end())
+			{
+				checkSize(nextSlot);
+				partialSlots.push_back(make_pair(nextSlot++, 0));
+				slot = partialSlots.end() - 1;
+			}
+			offsets[segmentStart + i] = make_pair(u256(slot->first), slot->second);
+			slot->second += bytes;
+			if (slot->second == 32)
+				partialSlots.erase(slot);
+		}
+		for (size_t i: fullSlots)
+		{
+			checkSize(nextSlot);
+			offsets[segmentStart + i] = make_pair(u256(nextSlot), 0);
+			nextSlot += types[i]->storageSize();
+		}
+		segmentStart += types.size();
+	}
+	checkSize(nextSlot);
+	m_storageSize = u256(nextSlot);
+	swap(m_offsets, offsets);
+}
+
 pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 {
 	if (m_offsets.count(_index))
@@ -92,16 +153,50 @@ MemberList& MemberList::operator=(MemberList&& _other)
 
 	m_memberTypes = move(_other.m_memberTypes);
 	m_storageOffsets = move(_other.m_storageOffsets);
+	m_memberIndex = move(_other.m_memberIndex);
 	return *this;
 }
 
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	buildMemberIndex();
+}
+
+TypePointer MemberList::memberType(string const& _name) const
+{
+	vector<size_t> const* positions = memberPositions(_name);
+	if (!positions)
+		return TypePointer();
+	solAssert(positions->size() == 1, "Requested member type by non-unique name.");
+	return m_memberTypes[positions->front()].type;
+}
+
+MemberList::MemberMap MemberList::membersByName(string const& _name) const
+{
+	MemberMap members;
+	if (vector<size_t> const* positions = memberPositions(_name))
+		for (size_t position: *positions)
+			members.push_back(m_memberTypes[position]);
+	return members;
+}
+
+vector<size_t> const* MemberList::memberPositions(string const& _name) const
+{
+	auto it = m_memberIndex.find(_name);
+	return it == m_memberIndex.end() ? nullptr : &it->second;
+}
+
+void MemberList::buildMemberIndex()
+{
+	m_memberIndex.clear();
+	for (size_t i = 0; i < m_memberTypes.size(); ++i)
+		m_memberIndex[m_memberTypes[i].name].push_back(i);
 }
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
+	lock_guard<mutex> lock(m_storageOffsetsMutex);
 	if (!m_storageOffsets)
 	{
 		TypePointers memberTypes;
@@ -128,6 +223,14 @@ u256 const& MemberList::storageSize() const
 namespace
 {
 
+/// Guards the member list caches of all types, which are shared between concurrently
+/// analysed contracts.
+mutex& membersMutex()
+{
+	static mutex s_mutex;
+	return s_mutex;
+}
+
 string parenthesizeIdentifier(string const& _internal)
 {
 	return "$_" + _internal + "_$";
@@ -182,29 +285,29 @@ TypePointer Type::fromElementaryTypeName(ElementaryTypeNameToken const& _type)
 	switch (token)
 	{
 	case Token::IntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(m, IntegerType::Modifier::Signed);
 	case Token::UIntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(m, IntegerType::Modifier::Unsigned);
 	case Token::BytesM:
-		return make_shared<FixedBytesType>(m);
+		return TypeProvider::fixedBytes(m);
 	case Token::FixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Signed);
 	case Token::UFixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Unsigned);
 	case Token::Int:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(256, IntegerType::Modifier::Signed);
 	case Token::UInt:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(256, IntegerType::Modifier::Unsigned);
 	case Token::Fixed:
-		return make_shared<FixedPointType>(128, 128, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(128, 128, FixedPointType::Modifier::Signed);
 	case Token::UFixed:
-		return make_shared<FixedPointType>(128, 128, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(128, 128, FixedPointType::Modifier::Unsigned);
 	case Token::Byte:
-		return make_shared<FixedBytesType>(1);
+		return TypeProvider::fixedBytes(1);
 	case Token::Address:
-		return make_shared<IntegerType>(0, IntegerType::Modifier::Address);
+		return TypeProvider::address();
 	case Token::Bool:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Bytes:
 		return make_shared<ArrayType>(DataLocation::Storage);
 	case Token::String:
@@ -232,7 +335,7 @@ TypePointer Type::forLiteral(Literal const& _literal)
 	{
 	case Token::TrueLiteral:
 	case Token::FalseLiteral:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Number:
 	{
 		tuple<bool, rational> validLiteral = RationalNumberType::isValidLiteral(_literal);
@@ -262,14 +365,20 @@ TypePointer Type::commonType(TypePointer const& _a, TypePointer const& _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
-	if (!m_members[_currentScope])
 	{
-		MemberList::MemberMap members = nativeMembers(_currentScope);
-		if (_currentScope)
-			members += boundFunctions(*this, *_currentScope);
-		m_members[_currentScope] = unique_ptr<MemberList>(new MemberList(move(members)));
+		lock_guard<mutex> lock(membersMutex());
+		auto it = m_members.find(_currentScope);
+		if (it != m_members.end())
+			return *it->second;
 	}
-	return *m_members[_currentScope];
+	// Computing the members can request members of other types, so this is done without
+	// holding the lock. If another thread was faster, its list is kept.
+	MemberList::MemberMap members = nativeMembers(_currentScope);
+	if (_currentScope)
+		members += boundFunctions(*this, *_currentScope);
+	unique_ptr<MemberList> list(new MemberList(move(members)));
+	lock_guard<mutex> lock(membersMutex());
+	return *m_members.emplace(_currentScope, move(list)).first->second;
 }
 
 MemberList::MemberMap Type::boundFunctions(Type const& _type, ContractDefinition const& _scope)
@@ -391,6 +500,8 @@ TypePointer IntegerType::unaryOperatorResult(Token::Value _operator) const
 
 bool IntegerType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	IntegerType const& other = dynamic_cast<IntegerType const&>(_other);
@@ -529,6 +640,8 @@ TypePointer FixedPointType::unaryOperatorResult(Token::Value _operator) const
 
 bool FixedPointType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FixedPointType const& other = dynamic_cast<FixedPointType const&>(_other);
@@ -570,6 +683,19 @@ TypePointer FixedPointType::binaryOperatorResult(Token::Value _operator, TypePoi
 	return commonType;
 }
 
+namespace
+{
+
+/// @returns the number of bits needed to represent the absolute value of @a _value.
+unsigned bitLength(bigint const& _value)
+{
+	return _value == 0 ? 0 : boost::multiprecision::msb(abs(_value)) + 1;
+}
+
+}
+
+unsigned const RationalNumberType::maxBits = 4096;
+
 tuple<bool, rational> RationalNumberType::isValidLiteral(Literal const& _literal)
 {
 	rational x;
@@ -746,101 +872,144 @@ TypePointer RationalNumberType::binaryOperatorResult(Token::Value _operator, Typ
 	else
 	{
 		rational value;
-		bool fractional = isFractional() || other.isFractional();
-		switch (_operator)
-		{
-		//bit operations will only be enabled for integers and fixed types that resemble integers
-		case Token::BitOr:
-			if (fractional)
-				return TypePointer();
-			value = m_value.numerator() | other.m_value.numerator();
-			break;
-		case Token::BitXor:
-			if (fractional)
-				return TypePointer();
-			value = m_value.numerator() ^ other.m_value.numerator();
-			break;
-		case Token::BitAnd:
-			if (fractional)
-				return TypePointer();
-			value = m_value.numerator() & other.m_value.numerator();
-			break;
-		case Token::Add:
-			value = m_value + other.m_value;
-			break;
-		case Token::Sub:
-			value = m_value - other.m_value;
-			break;
-		case Token::Mul:
-			value = m_value * other.m_value;
-			break;
-		case Token::Div:
-			if (other.m_value == 0)
-				return TypePointer();
-			else
-				value = m_value / other.m_value;
-			break;
-		case Token::Mod:
-			if (other.m_value == 0)
-				return TypePointer();
-			else if (fractional)
-			{
-				rational tempValue = m_value / other.m_value;
-				value = m_value - (tempValue.numerator() / tempValue.denominator()) * other.m_value;
-			}
-			else
-				value = m_value.numerator() % other.m_value.numerator();
-			break;	
-		case Token::Exp:
+		if (fold(_operator, other, value) != Folding::Success)
+			return TypePointer();
+		return make_shared<RationalNumberType>(value);
+	}
+}
+
+bool RationalNumberType::exceedsPrecision(Token::Value _operator, RationalNumberType const& _other) const
+{
+	rational value;
+	return fold(_operator, _other, value) == Folding::TooLarge;
+}
+
+RationalNumberType::Folding RationalNumberType::fold(
+	Token::Value _operator,
+	RationalNumberType const& _other,
+	rational& o_value
+) const
+{
+	rational value;
+	bool fractional = isFractional() || _other.isFractional();
+	switch (_operator)
+	{
+	//bit operations will only be enabled for integers and fixed types that resemble integers
+	case Token::BitOr:
+		if (fractional)
+			return Folding::Invalid;
+		value = m_value.numerator() | _other.m_value.numerator();
+		break;
+	case Token::BitXor:
+		if (fractional)
+			return Folding::Invalid;
+		value = m_value.numerator() ^ _other.m_value.numerator();
+		break;
+	case Token::BitAnd:
+		if (fractional)
+			return Folding::Invalid;
+		value = m_value.numerator() & _other.m_value.numerator();
+		break;
+	case Token::Add:
+		value = m_value + _other.m_value;
+		break;
+	case Token::Sub:
+		value = m_value - _other.m_value;
+		break;
+	case Token::Mul:
+		value = m_value * _other.m_value;
+		break;
+	case Token::Div:
+		if (_other.m_value == 0)
+			return Folding::Invalid;
+		else
+			value = m_value / _other.m_value;
+		break;
+	case Token::Mod:
+		if (_other.m_value == 0)
+			return Folding::Invalid;
+		else if (fractional)
 		{
-			using boost::multiprecision::pow;
-			if (other.isFractional())
-				return TypePointer();
-			else if (abs(other.m_value) > numeric_limits<uint32_t>::max())
-				return TypePointer(); // This will need too much memory to represent.
-			uint32_t exponent = abs(other.m_value).numerator().convert_to<uint32_t>();
-			bigint numerator = pow(m_value.numerator(), exponent);
-			bigint denominator = pow(m_value.denominator(), exponent);
-			if (other.m_value >= 0)
-				value = rational(numerator, denominator);
-			else
-				// invert
-				value = rational(denominator, numerator);
-			break;
+			rational tempValue = m_value / _other.m_value;
+			value = m_value - (tempValue.numerator() / tempValue.denominator()) * _other.m_value;
 		}
-		case Token::SHL:
+		else
+			value = m_value.numerator() % _other.m_value.numerator();
+		break;	
+	case Token::Exp:
+	{
+		using boost::multiprecision::pow;
+		if (_other.isFractional())
+			return Folding::Invalid;
+		bigint const& exponent = _other.m_value.numerator();
+		if (m_value == 0)
 		{
-			using boost::multiprecision::pow;
-			if (fractional)
-				return TypePointer();
-			else if (other.m_value < 0)
-				return TypePointer();
-			else if (other.m_value > numeric_limits<uint32_t>::max())
-				return TypePointer();
-			uint32_t exponent = other.m_value.numerator().convert_to<uint32_t>();
-			value = m_value.numerator() * pow(bigint(2), exponent);
+			if (exponent < 0)
+				return Folding::Invalid;
+			value = exponent == 0 ? 1 : 0;
 			break;
 		}
-		// NOTE: we're using >> (SAR) to denote right shifting. The type of the LValue
-		//       determines the resulting type and the type of shift (SAR or SHR).
-		case Token::SAR:
+		else if (m_value == 1 || m_value == -1)
 		{
-			using boost::multiprecision::pow;
-			if (fractional)
-				return TypePointer();
-			else if (other.m_value < 0)
-				return TypePointer();
-			else if (other.m_value > numeric_limits<uint32_t>::max())
-				return TypePointer();
-			uint32_t exponent = other.m_value.numerator().convert_to<uint32_t>();
-			value = rational(m_value.numerator() / pow(bigint(2), exponent), 1);
+			value = m_value < 0 && abs(exponent) % 2 == 1 ? -1 : 1;
 			break;
 		}
-		default:
-			return TypePointer();
+		// The result has at least this many bits, so reject it before computing it.
+		unsigned baseBits = max(bitLength(m_value.numerator()), bitLength(m_value.denominator()));
+		if (bigint(baseBits - 1) * abs(exponent) >= maxBits)
+			return Folding::TooLarge;
+		unsigned absExponent = abs(exponent).convert_to<unsigned>();
+		bigint numerator = pow(m_value.numerator(), absExponent);
+		bigint denominator = pow(m_value.denominator(), absExponent);
+		if (exponent >= 0)
+			value = rational(numerator, denominator);
+		else
+			// invert
+			value = rational(denominator, numerator);
+		break;
+	}
+	case Token::SHL:
+	{
+		if (fractional)
+			return Folding::Invalid;
+		else if (_other.m_value < 0)
+			return Folding::Invalid;
+		else if (m_value == 0)
+			value = 0;
+		else if (bitLength(m_value.numerator()) + _other.m_value.numerator() > maxBits)
+			return Folding::TooLarge;
+		else
+			value = m_value.numerator() << _other.m_value.numerator().convert_to<unsigned>();
+		break;
+	}
+	// NOTE: we're using >> (SAR) to denote right shifting. The type of the LValue
+	//       determines the resulting type and the type of shift (SAR or SHR).
+	case Token::SAR:
+	{
+		using boost::multiprecision::pow;
+		if (fractional)
+			return Folding::Invalid;
+		else if (_other.m_value < 0)
+			return Folding::Invalid;
+		else if (_other.m_value > numeric_limits<uint32_t>::max())
+			return Folding::Invalid;
+		else if (_other.m_value.numerator() >= bitLength(m_value.numerator()))
+			// All bits are shifted out.
+			value = 0;
+		else
+		{
+			unsigned shift = _other.m_value.numerator().convert_to<unsigned>();
+			value = rational(m_value.numerator() / pow(bigint(2), shift), 1);
 		}
-		return make_shared<RationalNumberType>(value);
+		break;
+	}
+	default:
+		return Folding::Invalid;
 	}
+	if (bitLength(value.numerator()) > maxBits || bitLength(value.denominator()) > maxBits)
+		return Folding::TooLarge;
+	o_value = value;
+	return Folding::Success;
 }
 
 string RationalNumberType::identifier() const
@@ -911,7 +1080,7 @@ shared_ptr<IntegerType const> RationalNumberType::integerType() const
 	if (value > u256(-1))
 		return shared_ptr<IntegerType const>();
 	else
-		return make_shared<IntegerType>(
+		return TypeProvider::integer(
 			max(bytesRequired(value), 1u) * 8,
 			negative ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned
 		);
@@ -963,7 +1132,7 @@ shared_ptr<FixedPointType const> RationalNumberType::fixedPointType() const
 		fractionalBits = 8;
 	}
 
-	return make_shared<FixedPointType>(
+	return TypeProvider::fixedPoint(
 		integerBits, fractionalBits,
 		negative ? FixedPointType::Modifier::Signed : FixedPointType::Modifier::Unsigned
 	);
@@ -1021,11 +1190,11 @@ bool StringLiteralType::isValidUTF8() const
 	return dev::validateUTF8(m_value);
 }
 
-shared_ptr<FixedBytesType> FixedBytesType::smallestTypeForLiteral(string const& _literal)
+shared_ptr<FixedBytesType const> FixedBytesType::smallestTypeForLiteral(string const& _literal)
 {
 	if (_literal.length() <= 32)
-		return make_shared<FixedBytesType>(_literal.length());
-	return shared_ptr<FixedBytesType>();
+		return TypeProvider::fixedBytes(_literal.length());
+	return shared_ptr<FixedBytesType const>();
 }
 
 FixedBytesType::FixedBytesType(int _bytes): m_bytes(_bytes)
@@ -1084,7 +1253,7 @@ TypePointer FixedBytesType::binaryOperatorResult(Token::Value _operator, TypePoi
 
 MemberList::MemberMap FixedBytesType::nativeMembers(const ContractDefinition*) const
 {
-	return MemberList::MemberMap{MemberList::Member{"length", make_shared<IntegerType>(8)}};
+	return MemberList::MemberMap{MemberList::Member{"length", TypeProvider::integer(8)}};
 }
 
 string FixedBytesType::identifier() const
@@ -1094,6 +1263,8 @@ string FixedBytesType::identifier() const
 
 bool FixedBytesType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FixedBytesType const& other = dynamic_cast<FixedBytesType const&>(_other);
@@ -1158,6 +1329,11 @@ TypePointer ContractType::unaryOperatorResult(Token::Value _operator) const
 	return _operator == Token::Delete ? make_shared<TupleType>() : TypePointer();
 }
 
+TypePointer ContractType::encodingType() const
+{
+	return TypeProvider::address();
+}
+
 TypePointer ReferenceType::unaryOperatorResult(Token::Value _operator) const
 {
 	if (_operator != Token::Delete)
@@ -1219,6 +1395,13 @@ string ReferenceType::identifierLocationSuffix() const
 	return id;
 }
 
+ArrayType::ArrayType(DataLocation _location, bool _isString):
+	ReferenceType(_location),
+	m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
+	m_baseType(TypeProvider::fixedBytes(1))
+{
+}
+
 bool ArrayType::isImplicitlyConvertibleTo(const Type& _convertTo) const
 {
 	if (_convertTo.category() != category())
@@ -1397,11 +1580,11 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 	MemberList::MemberMap members;
 	if (!isString())
 	{
-		members.push_back({"length", make_shared<IntegerType>(256)});
+		members.push_back({"length", TypeProvider::uint256()});
 		if (isDynamicallySized() && location() == DataLocation::Storage)
 			members.push_back({"push", make_shared<FunctionType>(
 				TypePointers{baseType()},
-				TypePointers{make_shared<IntegerType>(256)},
+				TypePointers{TypeProvider::uint256()},
 				strings{string()},
 				strings{string()},
 				isByteArray() ? FunctionType::Location::ByteArrayPush : FunctionType::Location::ArrayPush
@@ -1413,7 +1596,7 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 TypePointer ArrayType::encodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return this->copyForLocation(DataLocation::Memory, true);
 }
@@ -1421,7 +1604,7 @@ TypePointer ArrayType::encodingType() const
 TypePointer ArrayType::decodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return shared_from_this();
 }
@@ -1510,7 +1693,7 @@ string ContractType::canonicalName(bool) const
 MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const*) const
 {
 	// All address members and all interface functions
-	MemberList::MemberMap members(IntegerType(120, IntegerType::Modifier::Address).nativeMembers(nullptr));
+	MemberList::MemberMap members(TypeProvider::address()->nativeMembers(nullptr));
 	if (m_super)
 	{
 		// add the most derived of all functions which are visible in derived contracts
@@ -1557,23 +1740,36 @@ MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const*) con
 
 shared_ptr<FunctionType const> const& ContractType::newExpressionType() const
 {
+	lock_guard<mutex> lock(m_constructorTypeMutex);
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
 }
 
-vector<tuple<VariableDeclaration const*, u256, unsigned>> ContractType::stateVariables() const
+vector<tuple<VariableDeclaration const*, u256, unsigned>> ContractType::stateVariables(bool _packed) const
 {
 	vector<VariableDeclaration const*> variables;
+	vector<TypePointers> segments;
 	for (ContractDefinition const* contract: boost::adaptors::reverse(m_contract.annotation().linearizedBaseContracts))
+	{
+		segments.push_back(TypePointers());
 		for (VariableDeclaration const* variable: contract->stateVariables())
 			if (!variable->isConstant())
+			{
 				variables.push_back(variable);
-	TypePointers types;
-	for (auto variable: variables)
-		types.push_back(variable->annotation().type);
+				segments.back().push_back(variable->annotation().type);
+			}
+	}
 	StorageOffsets offsets;
-	offsets.computeOffsets(types);
+	if (_packed)
+		offsets.computePackedOffsets(segments);
+	else
+	{
+		TypePointers types;
+		for (TypePointers const& segment: segments)
+			types += segment;
+		offsets.computeOffsets(types);
+	}
 
 	vector<tuple<VariableDeclaration const*, u256, unsigned>> variablesAndOffsets;
 	for (size_t index = 0; index < variables.size(); ++index)
@@ -1664,6 +1860,11 @@ MemberList::MemberMap StructType::nativeMembers(ContractDefinition const*) const
 	return members;
 }
 
+TypePointer StructType::encodingType() const
+{
+	return location() == DataLocation::Storage ? TypeProvider::uint256() : TypePointer();
+}
+
 TypePointer StructType::interfaceType(bool _inLibrary) const
 {
 	if (_inLibrary && location() == DataLocation::Storage)
@@ -1740,6 +1941,11 @@ TypePointer EnumType::unaryOperatorResult(Token::Value _operator) const
 	return _operator == Token::Delete ? make_shared<TupleType>() : TypePointer();
 }
 
+TypePointer EnumType::encodingType() const
+{
+	return TypeProvider::integer(8 * int(storageBytes()));
+}
+
 string EnumType::identifier() const
 {
 	return "t_enum" + parenthesizeUserIdentifier(m_enum.name()) + std::to_string(m_enum.id());
@@ -1953,7 +2159,7 @@ FunctionType::FunctionType(VariableDeclaration const& _varDecl):
 				break;
 			returnType = arrayType->baseType();
 			paramNames.push_back("");
-			paramTypes.push_back(make_shared<IntegerType>(256));
+			paramTypes.push_back(TypeProvider::uint256());
 		}
 		else
 			break;
@@ -2414,6 +2620,10 @@ string FunctionType::externalSignature() const
 {
 	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
 
+	if (auto annotation = dynamic_cast<ExternalSignatureAnnotation const*>(&m_declaration->annotation()))
+		if (!annotation->externalSignature.empty())
+			return annotation->externalSignature;
+
 	bool _inLibrary = dynamic_cast<ContractDefinition const&>(*m_declaration->scope()).isLibrary();
 
 	string ret = m_declaration->name() + "(";
@@ -2430,9 +2640,19 @@ string FunctionType::externalSignature() const
 	return ret + ")";
 }
 
+h256 FunctionType::externalSignatureHash() const
+{
+	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
+
+	if (auto annotation = dynamic_cast<ExternalSignatureAnnotation const*>(&m_declaration->annotation()))
+		if (!annotation->externalSignature.empty())
+			return annotation->externalSignatureHash;
+	return dev::keccak256(externalSignature());
+}
+
 u256 FunctionType::externalIdentifier() const
 {
-	return FixedHash<4>::Arith(FixedHash<4>(dev::keccak256(externalSignature())));
+	return FixedHash<4>::Arith(FixedHash<4>(externalSignatureHash()));
 }
 
 TypePointers FunctionType::parseElementaryTypeVector(strings const& _types)
@@ -2541,6 +2761,11 @@ bool MappingType::operator==(Type const& _other) const
 	return *other.m_keyType == *m_keyType && *other.m_valueType == *m_valueType;
 }
 
+TypePointer MappingType::encodingType() const
+{
+	return TypeProvider::uint256();
+}
+
 string MappingType::toString(bool _short) const
 {
 	return "mapping(" + keyType()->toString(_short) + " => " + valueType()->toString(_short) + ")";
@@ -2725,25 +2950,25 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 	{
 	case Kind::Block:
 		return MemberList::MemberMap({
-			{"coinbase", make_shared<IntegerType>(0, IntegerType::Modifier::Address)},
-			{"timestamp", make_shared<IntegerType>(256)},
+			{"coinbase", TypeProvider::address()},
+			{"timestamp", TypeProvider::uint256()},
 			{"blockhash", make_shared<FunctionType>(strings{"uint"}, strings{"bytes32"}, FunctionType::Location::BlockHash)},
-			{"difficulty", make_shared<IntegerType>(256)},
-			{"number", make_shared<IntegerType>(256)},
-			{"gaslimit", make_shared<IntegerType>(256)}
+			{"difficulty", TypeProvider::uint256()},
+			{"number", TypeProvider::uint256()},
+			{"gaslimit", TypeProvider::uint256()}
 		});
 	case Kind::Message:
 		return MemberList::MemberMap({
-			{"sender", make_shared<IntegerType>(0, IntegerType::Modifier::Address)},
-			{"gas", make_shared<IntegerType>(256)},
-			{"value", make_shared<IntegerType>(256)},
+			{"sender", TypeProvider::address()},
+			{"gas", TypeProvider::uint256()},
+			{"value", TypeProvider::uint256()},
 			{"data", make_shared<ArrayType>(DataLocation::CallData)},
-			{"sig", make_shared<FixedBytesType>(4)}
+			{"sig", TypeProvider::fixedBytes(4)}
 		});
 	case Kind::Transaction:
 		return MemberList::MemberMap({
-			{"origin", make_shared<IntegerType>(0, IntegerType::Modifier::Address)},
-			{"gasprice", make_shared<IntegerType>(256)}
+			{"origin", TypeProvider::address()},
+			{"gasprice", TypeProvider::uint256()}
 		});
 	default:
 		BOOST_THROW_EXCEPTION(InternalCompilerError() << errinfo_comment("Unknown kind of magic."));
@@ -2764,3 +2989,8 @@ string MagicType::toString(bool) const
 		BOOST_THROW_EXCEPTION(InternalCompilerError() << errinfo_comment("Unknown kind of magic."));
 	}
 }
+
+TypePointer InaccessibleDynamicType::decodingType() const
+{
+	return TypeProvider::uint256();
+}
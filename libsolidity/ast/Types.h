@@ -34,8 +34,10 @@
 #include <boost/rational.hpp>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <map>
+#include <unordered_map>
 
 namespace dev
 {
@@ -61,6 +63,13 @@ public:
 	/// Resets the StorageOffsets objects and determines the position in storage for each
 	/// of the elements of @a _types.
 	void computeOffsets(TypePointers const& _types);
+	/// Resets the StorageOffsets objects and determines positions for the concatenation of
+	/// @a _segments, where the elements of each segment are reordered to minimise the number of
+	/// slots (first fit decreasing by storage bytes). Elements may fill space that previous
+	/// segments left unused in their slots. This never moves the elements of previous segments,
+	/// so the positions of the elements of a prefix of the segments do not depend on the later
+	/// segments.
+	void computePackedOffsets(std::vector<TypePointers> const& _segments);
 	/// @returns the offset of the given member, might be null if the member is not part of storage.
 	std::pair<u256, unsigned> const* offset(size_t _index) const;
 	/// @returns the total number of slots occupied by all members.
@@ -94,28 +103,11 @@ public:
 	using MemberMap = std::vector<Member>;
 
 	MemberList() {}
-	explicit MemberList(MemberMap const& _members): m_memberTypes(_members) {}
+	explicit MemberList(MemberMap const& _members): m_memberTypes(_members) { buildMemberIndex(); }
 	MemberList& operator=(MemberList&& _other);
 	void combine(MemberList const& _other);
-	TypePointer memberType(std::string const& _name) const
-	{
-		TypePointer type;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
-		return type;
-	}
-	MemberMap membersByName(std::string const& _name) const
-	{
-		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
-		return members;
-	}
+	TypePointer memberType(std::string const& _name) const;
+	MemberMap membersByName(std::string const& _name) const;
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
 	/// a nullptr if the member is not part of storage.
 	std::pair<u256, unsigned> const* memberStorageOffset(std::string const& _name) const;
@@ -126,7 +118,17 @@ public:
 	MemberMap::const_iterator end() const { return m_memberTypes.end(); }
 
 private:
+	/// @returns the positions of the members called @a _name in m_memberTypes or nullptr if
+	/// there is no such member.
+	std::vector<size_t> const* memberPositions(std::string const& _name) const;
+	void buildMemberIndex();
+
 	MemberMap m_memberTypes;
+	/// Index from member names to positions in m_memberTypes.
+	std::unordered_map<std::string, std::vector<size_t>> m_memberIndex;
+	/// Member lists are shared between concurrently analysed contracts, so the lazily
+	/// computed storage offsets are guarded by a mutex.
+	mutable std::mutex m_storageOffsetsMutex;
 	mutable std::unique_ptr<StorageOffsets> m_storageOffsets;
 };
 
@@ -381,6 +383,10 @@ public:
 
 	virtual Category category() const override { return Category::RationalNumber; }
 
+	/// Maximum number of bits of the numerator and of the denominator of a rational constant.
+	/// Operations whose results would be larger are rejected without computing them.
+	static unsigned const maxBits;
+
 	/// @returns true if the literal is a valid integer.
 	static std::tuple<bool, rational> isValidLiteral(Literal const& _literal);
 	
@@ -411,7 +417,17 @@ public:
 	/// @returns true if the value is not an integer.
 	bool isFractional() const { return m_value.denominator() != 1; }
 
+	/// @returns true if @a binaryOperatorResult rejects applying @a _operator to this and
+	/// @a _other only because the result would exceed @a maxBits.
+	bool exceedsPrecision(Token::Value _operator, RationalNumberType const& _other) const;
+
 private:
+	enum class Folding { Success, Invalid, TooLarge };
+
+	/// Computes the result of applying the binary operator @a _operator to this and @a _other
+	/// and stores it in @a o_value on success.
+	Folding fold(Token::Value _operator, RationalNumberType const& _other, rational& o_value) const;
+
 	rational m_value;
 };
 
@@ -459,7 +475,7 @@ public:
 
 	/// @returns the smallest bytes type for the given literal or an empty pointer
 	/// if no type fits.
-	static std::shared_ptr<FixedBytesType> smallestTypeForLiteral(std::string const& _literal);
+	static std::shared_ptr<FixedBytesType const> smallestTypeForLiteral(std::string const& _literal);
 
 	explicit FixedBytesType(int _bytes);
 
@@ -571,12 +587,7 @@ public:
 	virtual Category category() const override { return Category::Array; }
 
 	/// Constructor for a byte array ("bytes") and string.
-	explicit ArrayType(DataLocation _location, bool _isString = false):
-		ReferenceType(_location),
-		m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
-		m_baseType(std::make_shared<FixedBytesType>(1))
-	{
-	}
+	explicit ArrayType(DataLocation _location, bool _isString = false);
 	/// Constructor for a dynamically sized array type ("type[]")
 	ArrayType(DataLocation _location, TypePointer const& _baseType):
 		ReferenceType(_location),
@@ -657,10 +668,7 @@ public:
 	virtual std::string canonicalName(bool _addDataLocation) const override;
 
 	virtual MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	virtual TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(160, IntegerType::Modifier::Address);
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : encodingType();
@@ -678,14 +686,18 @@ public:
 
 	/// @returns a list of all state variables (including inherited) of the contract and their
 	/// offsets in storage.
-	std::vector<std::tuple<VariableDeclaration const*, u256, unsigned>> stateVariables() const;
+	/// @param _packed if true, the variables of each contract in the inheritance hierarchy are
+	/// reordered to use as few slots as possible, @see StorageOffsets::computePackedOffsets.
+	std::vector<std::tuple<VariableDeclaration const*, u256, unsigned>> stateVariables(bool _packed = false) const;
 
 private:
 	ContractDefinition const& m_contract;
 	/// If true, it is the "super" type of the current contract, i.e. it contains only inherited
 	/// members.
 	bool m_super = false;
-	/// Type of the constructor, @see constructorType. Lazily initialized.
+	/// Type of the constructor, @see constructorType. Lazily initialized, guarded by a mutex
+	/// since contract types are shared between concurrently analysed contracts.
+	mutable std::mutex m_constructorTypeMutex;
 	mutable FunctionTypePointer m_constructorType;
 };
 
@@ -708,10 +720,7 @@ public:
 	virtual std::string toString(bool _short) const override;
 
 	virtual MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	virtual TypePointer encodingType() const override
-	{
-		return location() == DataLocation::Storage ? std::make_shared<IntegerType>(256) : TypePointer();
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override;
 
 	TypePointer copyForLocation(DataLocation _location, bool _isPointer) const override;
@@ -756,10 +765,7 @@ public:
 	virtual bool isValueType() const override { return true; }
 
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	virtual TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(8 * int(storageBytes()));
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : encodingType();
@@ -955,7 +961,10 @@ public:
 	bool isBareCall() const;
 	Location const& location() const { return m_location; }
 	/// @returns the external signature of this function type given the function name
+	/// Uses the signature stored in the annotation of the declaration if present.
 	std::string externalSignature() const;
+	/// @returns the Keccak-256 hash of the external signature.
+	h256 externalSignatureHash() const;
 	/// @returns the external identifier of this function (the hash of the signature).
 	u256 externalIdentifier() const;
 	Declaration const& declaration() const
@@ -1024,10 +1033,7 @@ public:
 	virtual std::string toString(bool _short) const override;
 	virtual std::string canonicalName(bool _addDataLocation) const override;
 	virtual bool canLiveOutsideStorage() const override { return false; }
-	virtual TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(256);
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : TypePointer();
@@ -1170,7 +1176,7 @@ public:
 	virtual bool isValueType() const override { return true; }
 	virtual unsigned sizeOnStack() const override { return 1; }
 	virtual std::string toString(bool) const override { return "inaccessible dynamic type"; }
-	virtual TypePointer decodingType() const override { return std::make_shared<IntegerType>(256); }
+	virtual TypePointer decodingType() const override;
 };
 
 }
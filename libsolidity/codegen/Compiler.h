@@ -24,8 +24,10 @@
 
 #include <ostream>
 #include <functional>
+#include <memory>
 #include <libsolidity/codegen/CompilerContext.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 namespace dev {
 namespace solidity {
@@ -33,9 +35,19 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(bool _optimize = false, unsigned _runs = 200):
+	/// @param _constantCache cache for the constant optimiser that can be shared between
+	/// compilers, a new one is used for each optimisation run if not given.
+	/// @param _packStorage if true, state variables are reordered to use fewer storage slots.
+	explicit Compiler(
+		bool _optimize = false,
+		unsigned _runs = 200,
+		std::shared_ptr<eth::ComputeMethodCache> const& _constantCache = nullptr,
+		bool _packStorage = false
+	):
 		m_optimize(_optimize),
 		m_optimizeRuns(_runs),
+		m_packStorage(_packStorage),
+		m_constantCache(_constantCache),
 		m_runtimeContext(),
 		m_context(&m_runtimeContext)
 	{ }
@@ -56,10 +68,17 @@ public:
 	eth::LinkerObject runtimeObject() { return m_context.assembledRuntimeObject(m_runtimeSub); }
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// @arg _inJsonFromat shows whether the out should be in Json format
-	Json::Value streamAssembly(std::ostream& _stream, StringMap const& _sourceCodes = StringMap(), bool _inJsonFormat = false) const
+	void streamAssembly(std::ostream& _stream, StringMap const& _sourceCodes = StringMap(), bool _inJsonFormat = false) const
 	{
-		return m_context.streamAssembly(_stream, _sourceCodes, _inJsonFormat);
+		m_context.streamAssembly(_stream, _sourceCodes, _inJsonFormat);
 	}
+	/// @returns the assembly in JSON format.
+	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const
+	{
+		return m_context.assemblyJSON(_sourceCodes);
+	}
+	/// Streams the assembly in the compact binary format to @a _stream.
+	void streamAssemblyBinary(std::ostream& _stream) const { m_context.assembly().streamBinary(_stream); }
 	/// @returns Assembly items of the normal compiler context
 	eth::AssemblyItems const& assemblyItems() const { return m_context.assembly().items(); }
 	/// @returns Assembly items of the runtime compiler context
@@ -72,6 +91,8 @@ public:
 private:
 	bool const m_optimize;
 	unsigned const m_optimizeRuns;
+	bool const m_packStorage;
+	std::shared_ptr<eth::ComputeMethodCache> m_constantCache;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
@@ -160,7 +160,7 @@ FunctionDefinition const& CompilerContext::resolveVirtualFunction(FunctionDefini
 		if (scope->isLibrary())
 			return _function;
 	solAssert(!m_inheritanceHierarchy.empty(), "No inheritance hierarchy set.");
-	return resolveVirtualFunction(_function, m_inheritanceHierarchy.begin());
+	return *m_inheritanceHierarchy.front()->overrideChain(_function).front();
 }
 
 FunctionDefinition const& CompilerContext::superFunction(FunctionDefinition const& _function, ContractDefinition const& _base)
@@ -300,18 +300,12 @@ FunctionDefinition const& CompilerContext::resolveVirtualFunction(
 	vector<ContractDefinition const*>::const_iterator _searchStart
 )
 {
-	string name = _function.name();
-	FunctionType functionType(_function);
-	auto it = _searchStart;
-	for (; it != m_inheritanceHierarchy.end(); ++it)
-		for (FunctionDefinition const* function: (*it)->definedFunctions())
-			if (
-				function->name() == name &&
-				!function->isConstructor() &&
-				FunctionType(*function).hasEqualArgumentTypes(functionType)
-			)
-				return *function;
-	solAssert(false, "Super function " + name + " not found.");
+	// The override chain is ordered like the inheritance hierarchy, so the first function that is
+	// defined in a contract at or after the search start is the one we look for.
+	for (FunctionDefinition const* function: m_inheritanceHierarchy.front()->overrideChain(_function))
+		if (find(_searchStart, m_inheritanceHierarchy.cend(), function->scope()) != m_inheritanceHierarchy.cend())
+			return *function;
+	solAssert(false, "Super function " + _function.name() + " not found.");
 	return _function; // not reached
 }
 
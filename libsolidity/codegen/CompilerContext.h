@@ -186,7 +186,10 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	void optimise(bool _fullOptimsation, unsigned _runs = 200) { m_asm->optimise(_fullOptimsation, true, _runs); }
+	void optimise(bool _fullOptimsation, unsigned _runs = 200, eth::ComputeMethodCache* _constantCache = nullptr)
+	{
+		m_asm->optimise(_fullOptimsation, true, _runs, _constantCache);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() { return m_runtimeContext; }
@@ -200,10 +203,12 @@ public:
 
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// @arg _inJsonFormat shows whether the out should be in Json format
-	Json::Value streamAssembly(std::ostream& _stream, StringMap const& _sourceCodes = StringMap(), bool _inJsonFormat = false) const
+	void streamAssembly(std::ostream& _stream, StringMap const& _sourceCodes = StringMap(), bool _inJsonFormat = false) const
 	{
-		return m_asm->stream(_stream, "", _sourceCodes, _inJsonFormat);
+		m_asm->stream(_stream, "", _sourceCodes, _inJsonFormat);
 	}
+	/// @returns the assembly in JSON format.
+	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const { return m_asm->assemblyJSON(_sourceCodes); }
 
 	eth::LinkerObject const& assembledObject() { return m_asm->assemble(); }
 	eth::LinkerObject const& assembledRuntimeObject(size_t _subIndex) { return m_asm->sub(_subIndex).assemble(); }
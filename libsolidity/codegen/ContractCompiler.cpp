@@ -402,7 +402,7 @@ void ContractCompiler::appendReturnValuePacker(TypePointers const& _typeParamete
 
 void ContractCompiler::registerStateVariables(ContractDefinition const& _contract)
 {
-	for (auto const& var: ContractType(_contract).stateVariables())
+	for (auto const& var: ContractType(_contract).stateVariables(m_packStorage))
 		m_context.addStateVariable(*get<0>(var), get<1>(var), get<2>(var));
 }
 
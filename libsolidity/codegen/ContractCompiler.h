@@ -38,8 +38,14 @@ namespace solidity {
 class ContractCompiler: private ASTConstVisitor
 {
 public:
-	explicit ContractCompiler(ContractCompiler* _runtimeCompiler, CompilerContext& _context, bool _optimise):
+	explicit ContractCompiler(
+		ContractCompiler* _runtimeCompiler,
+		CompilerContext& _context,
+		bool _optimise,
+		bool _packStorage = false
+	):
 		m_optimise(_optimise),
+		m_packStorage(_packStorage),
 		m_runtimeCompiler(_runtimeCompiler),
 		m_context(_context)
 	{
@@ -118,6 +124,8 @@ private:
 	static eth::AssemblyPointer cloneRuntime();
 
 	bool const m_optimise;
+	/// Whether state variables are reordered to use fewer storage slots.
+	bool const m_packStorage;
 	/// Pointer to the runtime compiler in case this is a creation compiler.
 	ContractCompiler* m_runtimeCompiler = nullptr;
 	CompilerContext& m_context;
@@ -511,7 +511,17 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				arguments[i]->accept(*this);
 				utils().convertType(*arguments[i]->annotation().type, *function.parameterTypes()[i]);
 			}
-			_functionCall.expression().accept(*this);
+			FunctionDefinition const* calledFunction = function.bound() ? nullptr : directlyCalledFunction(_functionCall.expression());
+			if (calledFunction)
+			{
+				// A function called by name is only needed in the current context, so we do not
+				// request its combined label, which would also compile it into the runtime code
+				// when called from the constructor.
+				CompilerContext::LocationSetter locationSetter(m_context, _functionCall.expression());
+				m_context << m_context.functionEntryLabel(*calledFunction).pushTag();
+			}
+			else
+				_functionCall.expression().accept(*this);
 			unsigned parameterSize = CompilerUtils::sizeOnStack(function.parameterTypes());
 			if (function.bound())
 			{
@@ -521,12 +531,15 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				parameterSize += function.selfType()->sizeOnStack();
 			}
 
-			if (m_context.runtimeContext())
-				// We have a runtime context, so we need the creation part.
-				m_context << (u256(1) << 32) << Instruction::SWAP1 << Instruction::DIV;
-			else
-				// Extract the runtime part.
-				m_context << ((u256(1) << 32) - 1) << Instruction::AND;
+			if (!calledFunction)
+			{
+				if (m_context.runtimeContext())
+					// We have a runtime context, so we need the creation part.
+					m_context << (u256(1) << 32) << Instruction::SWAP1 << Instruction::DIV;
+				else
+					// Extract the runtime part.
+					m_context << ((u256(1) << 32) - 1) << Instruction::AND;
+			}
 
 			m_context.appendJump(eth::AssemblyItem::JumpType::IntoFunction);
 			m_context << returnLabel;
@@ -719,7 +732,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				}
 			if (!event.isAnonymous())
 			{
-				m_context << u256(h256::Arith(dev::keccak256(function.externalSignature())));
+				m_context << u256(h256::Arith(function.externalSignatureHash()));
 				++numIndexed;
 			}
 			solAssert(numIndexed <= 4, "Too many indexed arguments.");
@@ -1740,6 +1753,32 @@ void ExpressionCompiler::appendExternalFunctionCall(
 	}
 }
 
+FunctionDefinition const* ExpressionCompiler::directlyCalledFunction(Expression const& _expression)
+{
+	if (auto identifier = dynamic_cast<Identifier const*>(&_expression))
+	{
+		if (auto function = dynamic_cast<FunctionDefinition const*>(identifier->annotation().referencedDeclaration))
+			return &m_context.resolveVirtualFunction(*function);
+	}
+	else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+	{
+		auto function = dynamic_cast<FunctionDefinition const*>(memberAccess->annotation().referencedDeclaration);
+		if (!function)
+			return nullptr;
+		Type const& type = *memberAccess->expression().annotation().type;
+		if (auto typeType = dynamic_cast<TypeType const*>(&type))
+		{
+			// Internal library functions and functions of base contracts.
+			if (dynamic_cast<ContractType const*>(typeType->actualType().get()))
+				return function;
+		}
+		else if (auto contractType = dynamic_cast<ContractType const*>(&type))
+			if (contractType->isSuper())
+				return &m_context.superFunction(*function, contractType->contractDefinition());
+	}
+	return nullptr;
+}
+
 void ExpressionCompiler::appendExpressionCopyToMemory(Type const& _expectedType, Expression const& _expression)
 {
 	solUnimplementedAssert(_expectedType.isValueType(), "Not implemented for non-value types.");
@@ -99,6 +99,9 @@ private:
 		FunctionType const& _functionType,
 		std::vector<ASTPointer<Expression const>> const& _arguments
 	);
+	/// @returns the function called by an internal function call with @a _expression as callee if
+	/// the function is referenced by name (and not via a function-type value), nullptr otherwise.
+	FunctionDefinition const* directlyCalledFunction(Expression const& _expression);
 	/// Appends code that evaluates a single expression and moves the result to memory. The memory offset is
 	/// expected to be on the stack and is updated by this call.
 	void appendExpressionCopyToMemory(Type const& _expectedType, Expression const& _expression);
@@ -137,9 +137,10 @@ assembly::Statement Parser::parseExpression()
 std::map<string, dev::solidity::Instruction> const& Parser::instructions()
 {
 	// Allowed instructions, lowercase names.
-	static map<string, dev::solidity::Instruction> s_instructions;
-	if (s_instructions.empty())
+	// Initialised only once (and thread-safely), sources can be parsed concurrently.
+	static map<string, dev::solidity::Instruction> const s_instructions = []()
 	{
+		map<string, dev::solidity::Instruction> instructions;
 		for (auto const& instruction: solidity::c_instructions)
 		{
 			if (
@@ -149,12 +150,13 @@ std::map<string, dev::solidity::Instruction> const& Parser::instructions()
 				continue;
 			string name = instruction.first;
 			transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
-			s_instructions[name] = instruction.second;
+			instructions[name] = instruction.second;
 		}
 
 		// add alias for selfdestruct
-		s_instructions["selfdestruct"] = solidity::Instruction::SUICIDE;
-	}
+		instructions["selfdestruct"] = solidity::Instruction::SUICIDE;
+		return instructions;
+	}();
 	return s_instructions;
 }
 
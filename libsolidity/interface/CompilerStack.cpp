@@ -30,6 +30,7 @@
 #include <libsolidity/parsing/Scanner.h>
 #include <libsolidity/parsing/Parser.h>
 #include <libsolidity/analysis/GlobalContext.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/analysis/DocStringAnalyser.h>
@@ -37,11 +38,15 @@
 #include <libsolidity/analysis/SyntaxChecker.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/interface/InterfaceHandler.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
+#include <libsolidity/interface/StorageLayout.h>
 #include <libsolidity/formal/Why3Translator.h>
 
 #include <libevmasm/Exceptions.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <libdevcore/SwarmHash.h>
+#include <libdevcore/SHA3.h>
 #include <libdevcore/JSON.h>
 
 #include <json/json.h>
@@ -49,13 +54,58 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+
 
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
+namespace
+{
+
+/// Runs @a _task for all indices from 0 to @a _count - 1, distributed over at most
+/// @a _maxThreads threads or, if it is zero, as many threads as there are cores.
+void forEachConcurrently(size_t _count, unsigned _maxThreads, function<void(size_t)> const& _task)
+{
+	atomic<size_t> next(0);
+	auto worker = [&]()
+	{
+		for (size_t i = next++; i < _count; i = next++)
+			_task(i);
+	};
+	size_t threads = min<size_t>(_count, _maxThreads ? _maxThreads : max(1u, thread::hardware_concurrency()));
+	vector<future<void>> helpers;
+	for (size_t i = 1; i < threads; ++i)
+		helpers.push_back(async(launch::async, worker));
+	worker();
+	for (auto& helper: helpers)
+		helper.get();
+}
+
+/// Parses the sources of @a _scanners concurrently, each into its own error list.
+vector<ParsedSource> parseConcurrently(vector<shared_ptr<Scanner>> const& _scanners, unsigned _maxThreads)
+{
+	vector<ParsedSource> results(_scanners.size());
+	forEachConcurrently(_scanners.size(), _maxThreads, [&](size_t i)
+	{
+		ASTNode::resetID();
+		_scanners[i]->reset();
+		results[i].ast = Parser(results[i].errors, make_shared<ASTArena>()).parse(_scanners[i]);
+		results[i].lastID = ASTNode::lastID();
+	});
+	return results;
+}
+
+}
+
 CompilerStack::CompilerStack(ReadFileCallback const& _readFile):
-	m_readFile(_readFile), m_parseSuccessful(false) {}
+	m_readFile(_readFile),
+	m_constantOptimiserDepth(eth::ComputeMethodCache::defaultMaxDepth),
+	m_parseSuccessful(false) {}
 
 void CompilerStack::setRemappings(vector<string> const& _remappings)
 {
@@ -75,8 +125,14 @@ void CompilerStack::setRemappings(vector<string> const& _remappings)
 	swap(m_remappings, remappings);
 }
 
+CompilerStack::~CompilerStack()
+{
+	releaseParsedSources();
+}
+
 void CompilerStack::reset(bool _keepSources)
 {
+	releaseParsedSources();
 	m_parseSuccessful = false;
 	if (_keepSources)
 		for (auto sourcePair: m_sources)
@@ -87,6 +143,8 @@ void CompilerStack::reset(bool _keepSources)
 	}
 	m_optimize = false;
 	m_optimizeRuns = 200;
+	m_constantCache.reset();
+	m_typeProvider.reset();
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
@@ -94,10 +152,15 @@ void CompilerStack::reset(bool _keepSources)
 }
 
 bool CompilerStack::addSource(string const& _name, string const& _content, bool _isLibrary)
+{
+	return addSource(_name, CharStream(_content), _isLibrary);
+}
+
+bool CompilerStack::addSource(string const& _name, CharStream const& _source, bool _isLibrary)
 {
 	bool existed = m_sources.count(_name) != 0;
 	reset(true);
-	m_sources[_name].scanner = make_shared<Scanner>(CharStream(_content), _name);
+	m_sources[_name].scanner = make_shared<Scanner>(_source, _name);
 	m_sources[_name].isLibrary = _isLibrary;
 	return existed;
 }
@@ -111,6 +174,7 @@ void CompilerStack::setSource(string const& _sourceCode)
 bool CompilerStack::parse()
 {
 	//reset
+	releaseParsedSources();
 	m_errors.clear();
 	ASTNode::resetID();
 	m_parseSuccessful = false;
@@ -126,27 +190,67 @@ bool CompilerStack::parse()
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 	map<string, SourceUnit const*> sourceUnitsByName;
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	// Sources are parsed in rounds: All sources known at the start of a round are parsed
+	// concurrently, the imports they reference are loaded afterwards on this thread (the
+	// callback need not be thread-safe) and parsed in the next round. Errors and node IDs
+	// are the same as if the sources were parsed one after another.
+	size_t lastID = 0;
+	for (size_t roundStart = 0; roundStart < sourcesToParse.size();)
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = Parser(m_errors).parse(source.scanner);
-		sourceUnitsByName[path] = source.ast.get();
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errors), "Parser returned null but did not report error.");
-		else
+		vector<string> paths(sourcesToParse.begin() + roundStart, sourcesToParse.end());
+		roundStart = sourcesToParse.size();
+		vector<ParsedSource> results(paths.size());
+		vector<size_t> toParse;
+		vector<shared_ptr<Scanner>> scanners;
+		for (size_t i = 0; i < paths.size(); ++i)
+		{
+			Source& source = m_sources[paths[i]];
+			if (m_parsedSourceCache)
+			{
+				vector_ref<char const> content = source.scanner->source();
+				source.contentHash = keccak256(bytesConstRef(reinterpret_cast<byte const*>(content.data()), content.size()));
+				results[i] = m_parsedSourceCache->take(paths[i], source.contentHash);
+				if (results[i].ast)
+					continue;
+			}
+			toParse.push_back(i);
+			scanners.push_back(source.scanner);
+		}
+		vector<ParsedSource> parsed = parseConcurrently(scanners, m_maxThreads);
+		for (size_t i = 0; i < toParse.size(); ++i)
+			results[toParse[i]] = move(parsed[i]);
+
+		for (size_t i = 0; i < paths.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			string const& path = paths[i];
+			Source& source = m_sources[path];
+			source.ast = results[i].ast;
+			m_errors.insert(m_errors.end(), results[i].errors.begin(), results[i].errors.end());
+			sourceUnitsByName[path] = source.ast.get();
+			if (!source.ast)
+				solAssert(!Error::containsOnlyWarnings(results[i].errors), "Parser returned null but did not report error.");
+			else
 			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents), newPath);
-				sourcesToParse.push_back(newPath);
+				source.ast->shiftIDs(lastID);
+				if (m_parsedSourceCache)
+				{
+					source.parseErrors = results[i].errors;
+					source.idOffset = lastID;
+					source.lastID = results[i].lastID;
+				}
+				source.ast->annotation().path = path;
+				for (auto& newSource: loadMissingSources(*source.ast, path))
+				{
+					string const& newPath = newSource.first;
+					auto newContents = make_shared<string const>(move(newSource.second));
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents), newPath);
+					sourcesToParse.push_back(newPath);
+				}
 			}
+			lastID += results[i].lastID;
 		}
 	}
+	ASTNode::resetID(lastID);
 	if (!Error::containsOnlyWarnings(m_errors))
 		// errors while parsing. should stop before type checking
 		return false;
@@ -164,6 +268,8 @@ bool CompilerStack::parse()
 		if (!docStringAnalyser.analyseDocStrings(*source->ast))
 			noErrors = false;
 
+	m_typeProvider = make_shared<TypeProvider>();
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	m_globalContext = make_shared<GlobalContext>();
 	NameAndTypeResolver resolver(m_globalContext->declarations(), m_errors);
 	for (Source const* source: m_sourceOrder)
@@ -192,29 +298,46 @@ bool CompilerStack::parse()
 					m_contracts[contract->fullyQualifiedName()].contract = contract;
 			}
 
+	vector<ContractDefinition*> contracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-			{
-				m_globalContext->setCurrentContract(*contract);
-				resolver.updateDeclaration(*m_globalContext->currentThis());
-				TypeChecker typeChecker(m_errors);
-				if (typeChecker.checkTypeRequirements(*contract))
-				{
-					contract->setDevDocumentation(InterfaceHandler::devDocumentation(*contract));
-					contract->setUserDocumentation(InterfaceHandler::userDocumentation(*contract));
-				}
-				else
-					noErrors = false;
+				contracts.push_back(contract);
+
+	// The members of different contracts are type checked concurrently, each contract into its
+	// own error list. The steps that depend on other contracts are run in order, so that the
+	// errors are the same as if all contracts were checked one after the other.
+	vector<ErrorList> contractErrors(contracts.size());
+	vector<unique_ptr<TypeChecker>> typeCheckers;
+	for (size_t i = 0; i < contracts.size(); ++i)
+	{
+		typeCheckers.emplace_back(new TypeChecker(contractErrors[i]));
+		typeCheckers[i]->checkContractDefinition(*contracts[i]);
+	}
+	forEachConcurrently(contracts.size(), m_maxThreads, [&](size_t i)
+	{
+		TypeProvider::Scope workerTypeProviderScope(*m_typeProvider);
+		ContractDefinition& contract = *contracts[i];
+		if (typeCheckers[i]->checkContractMembers(contract))
+		{
+			contract.setDevDocumentation(InterfaceHandler::devDocumentation(contract));
+			contract.setUserDocumentation(InterfaceHandler::userDocumentation(contract));
+		}
+	});
+	for (size_t i = 0; i < contracts.size(); ++i)
+	{
+		if (!typeCheckers[i]->registerContractCreations())
+			noErrors = false;
+		m_errors += contractErrors[i];
 
-				// Note that we now reference contracts by their fully qualified names, and
-				// thus contracts can only conflict if declared in the same source file.  This
-				// already causes a double-declaration error elsewhere, so we do not report
-				// an error here and instead silently drop any additional contracts we find.
+		// Note that we now reference contracts by their fully qualified names, and
+		// thus contracts can only conflict if declared in the same source file.  This
+		// already causes a double-declaration error elsewhere, so we do not report
+		// an error here and instead silently drop any additional contracts we find.
 
-				if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-					m_contracts[contract->fullyQualifiedName()].contract = contract;
-			}
+		if (m_contracts.find(contracts[i]->fullyQualifiedName()) == m_contracts.end())
+			m_contracts[contracts[i]->fullyQualifiedName()].contract = contracts[i];
+	}
 
 	if (noErrors)
 	{
@@ -254,6 +377,8 @@ bool CompilerStack::compile(bool _optimize, unsigned _runs, map<string, h160> co
 	m_optimize = _optimize;
 	m_optimizeRuns = _runs;
 	m_libraries = _libraries;
+	m_constantCache = make_shared<eth::ComputeMethodCache>(m_constantOptimiserDepth);
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
 	map<ContractDefinition const*, eth::Assembly const*> compiledContracts;
 	for (Source const* source: m_sourceOrder)
@@ -283,6 +408,7 @@ bool CompilerStack::prepareFormalAnalysis(ErrorList* _errors)
 {
 	if (!_errors)
 		_errors = &m_errors;
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	Why3Translator translator(*_errors);
 	for (Source const* source: m_sourceOrder)
 		if (!translator.process(*source->ast))
@@ -311,7 +437,7 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	if (!c.sourceMapping)
 	{
 		if (auto items = assemblyItems(_contractName))
-			c.sourceMapping.reset(new string(computeSourceMapping(*items)));
+			c.sourceMapping.reset(new string(compressSourceMapping(computeSourceMapEntries(*items))));
 	}
 	return c.sourceMapping.get();
 }
@@ -322,11 +448,57 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	if (!c.runtimeSourceMapping)
 	{
 		if (auto items = runtimeAssemblyItems(_contractName))
-			c.runtimeSourceMapping.reset(new string(computeSourceMapping(*items)));
+			c.runtimeSourceMapping.reset(new string(compressSourceMapping(computeSourceMapEntries(*items))));
 	}
 	return c.runtimeSourceMapping.get();
 }
 
+bytes const* CompilerStack::binarySourceMapping(string const& _contractName) const
+{
+	Contract const& c = contract(_contractName);
+	if (!c.binarySourceMapping)
+	{
+		if (auto items = assemblyItems(_contractName))
+			c.binarySourceMapping.reset(new bytes(BinarySourceMap::encode(
+				computeSourceMapEntries(*items),
+				object(_contractName).itemOffsets
+			)));
+	}
+	return c.binarySourceMapping.get();
+}
+
+bytes const* CompilerStack::runtimeBinarySourceMapping(string const& _contractName) const
+{
+	Contract const& c = contract(_contractName);
+	if (!c.runtimeBinarySourceMapping)
+	{
+		if (auto items = runtimeAssemblyItems(_contractName))
+			c.runtimeBinarySourceMapping.reset(new bytes(BinarySourceMap::encode(
+				computeSourceMapEntries(*items),
+				runtimeObject(_contractName).itemOffsets
+			)));
+	}
+	return c.runtimeBinarySourceMapping.get();
+}
+
+Json::Value CompilerStack::pcMapping(string const& _contractName) const
+{
+	return computePCMapping(assemblyItems(_contractName), object(_contractName));
+}
+
+Json::Value CompilerStack::runtimePCMapping(string const& _contractName) const
+{
+	return computePCMapping(runtimeAssemblyItems(_contractName), runtimeObject(_contractName));
+}
+
+Json::Value CompilerStack::storageLayout(string const& _contractName) const
+{
+	if (!m_parseSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing was not successful."));
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+	return StorageLayout::generate(*contract(_contractName).contract, m_packStorage);
+}
+
 std::string const CompilerStack::filesystemFriendlyName(string const& _contractName) const
 {
 	// Look up the contract (by its fully-qualified name)
@@ -372,16 +544,29 @@ dev::h256 CompilerStack::contractCodeHash(string const& _contractName) const
 		return dev::keccak256(obj.bytecode);
 }
 
-Json::Value CompilerStack::streamAssembly(ostream& _outStream, string const& _contractName, StringMap _sourceCodes, bool _inJsonFormat) const
+void CompilerStack::streamAssembly(ostream& _outStream, string const& _contractName, StringMap _sourceCodes, bool _inJsonFormat) const
 {
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
-		return currentContract.compiler->streamAssembly(_outStream, _sourceCodes, _inJsonFormat);
+		currentContract.compiler->streamAssembly(_outStream, _sourceCodes, _inJsonFormat);
 	else
-	{
 		_outStream << "Contract not fully implemented" << endl;
+}
+
+Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap _sourceCodes) const
+{
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.compiler)
+		return currentContract.compiler->assemblyJSON(_sourceCodes);
+	else
 		return Json::Value();
-	}
+}
+
+void CompilerStack::streamAssemblyBinary(ostream& _outStream, string const& _contractName) const
+{
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.compiler)
+		currentContract.compiler->streamAssemblyBinary(_outStream);
 }
 
 vector<string> CompilerStack::sourceNames() const
@@ -439,7 +624,10 @@ Json::Value const& CompilerStack::metadata(Contract const& _contract, Documentat
 
 	// caches the result
 	if (!*doc)
+	{
+		TypeProvider::Scope typeProviderScope(*m_typeProvider);
 		doc->reset(new Json::Value(InterfaceHandler::documentation(*_contract.contract, _type)));
+	}
 
 	return *(*doc);
 }
@@ -572,6 +760,32 @@ string CompilerStack::applyRemapping(string const& _path, string const& _context
 	return path;
 }
 
+void CompilerStack::releaseParsedSources()
+{
+	if (!m_parsedSourceCache)
+		return;
+	// Nothing may refer to the annotations after they are removed.
+	m_contracts.clear();
+	m_sourceOrder.clear();
+	m_globalContext.reset();
+	m_parseSuccessful = false;
+	for (auto& sourcePair: m_sources)
+	{
+		Source& source = sourcePair.second;
+		if (!source.ast)
+			continue;
+		source.ast->clearAnnotations();
+		// Restore the IDs the nodes had directly after parsing (unsigned arithmetic wraps around).
+		source.ast->shiftIDs(size_t(0) - source.idOffset);
+		ParsedSource parsed;
+		parsed.ast = move(source.ast);
+		parsed.errors = move(source.parseErrors);
+		parsed.lastID = source.lastID;
+		m_parsedSourceCache->store(sourcePair.first, source.contentHash, move(parsed));
+		source.ast.reset();
+	}
+}
+
 void CompilerStack::resolveImports()
 {
 	// topological sorting (depth first search) of the import graph, cutting potential cycles
@@ -633,7 +847,7 @@ void CompilerStack::compileContract(
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		compileContract(*dependency, _compiledContracts);
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_optimize, m_optimizeRuns);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_optimize, m_optimizeRuns, m_constantCache, m_packStorage);
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 	string onChainMetadata = createOnChainMetadata(compiledContract);
 	bytes cborEncodedMetadata =
@@ -652,7 +866,7 @@ void CompilerStack::compileContract(
 
 	try
 	{
-		Compiler cloneCompiler(m_optimize, m_optimizeRuns);
+		Compiler cloneCompiler(m_optimize, m_optimizeRuns, m_constantCache, m_packStorage);
 		cloneCompiler.compileClone(_contract, _compiledContracts);
 		compiledContract.cloneObject = cloneCompiler.assembledObject();
 	}
@@ -724,20 +938,25 @@ string CompilerStack::createOnChainMetadata(Contract const& _contract) const
 	for (auto const& s: m_sources)
 	{
 		solAssert(s.second.scanner, "Scanner not available");
-		meta["sources"][s.first]["keccak256"] =
-			"0x" + toHex(dev::keccak256(s.second.scanner->source()).asBytes());
+		vector_ref<char const> source = s.second.scanner->source();
+		bytesConstRef sourceBytes(reinterpret_cast<byte const*>(source.data()), source.size());
+		meta["sources"][s.first]["keccak256"] = "0x" + toHex(dev::keccak256(sourceBytes).asBytes());
 		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.scanner->source();
+			meta["sources"][s.first]["content"] = source.toString();
 		else
 		{
 			meta["sources"][s.first]["urls"] = Json::arrayValue;
 			meta["sources"][s.first]["urls"].append(
-				"bzzr://" + toHex(dev::swarmHash(s.second.scanner->source()).asBytes())
+				"bzzr://" + toHex(dev::swarmHash(sourceBytes).asBytes())
 			);
 		}
 	}
 	meta["settings"]["optimizer"]["enabled"] = m_optimize;
 	meta["settings"]["optimizer"]["runs"] = m_optimizeRuns;
+	if (m_constantOptimiserDepth != eth::ComputeMethodCache::defaultMaxDepth)
+		meta["settings"]["optimizer"]["constantDepth"] = m_constantOptimiserDepth;
+	if (m_packStorage)
+		meta["settings"]["packStorage"] = true;
 	meta["settings"]["compilationTarget"][_contract.contract->sourceUnitName()] =
 		_contract.contract->annotation().canonicalName;
 
@@ -759,75 +978,53 @@ string CompilerStack::createOnChainMetadata(Contract const& _contract) const
 	return jsonCompactPrint(meta);
 }
 
-string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) const
+Json::Value CompilerStack::computePCMapping(eth::AssemblyItems const* _items, eth::LinkerObject const& _object) const
 {
-	string ret;
-	map<string, unsigned> sourceIndicesMap = sourceIndices();
-	int prevStart = -1;
-	int prevLength = -1;
-	int prevSourceIndex = -1;
-	char prevJump = 0;
-	for (auto const& item: _items)
+	Json::Value ret(Json::arrayValue);
+	if (!_items)
+		return ret;
+	vector<SourceMapEntry> entries = computeSourceMapEntries(*_items);
+	solAssert(entries.size() == _object.itemOffsets.size(), "Assembly items and bytecode offsets do not match.");
+	for (size_t i = 0; i < entries.size(); ++i)
 	{
-		if (!ret.empty())
-			ret += ";";
+		Json::Value row(Json::arrayValue);
+		row.append(Json::UInt64(_object.itemOffsets[i]));
+		row.append(entries[i].start);
+		row.append(entries[i].length);
+		row.append(entries[i].sourceIndex);
+		row.append(string(1, entries[i].jump));
+		ret.append(row);
+	}
+	return ret;
+}
 
+vector<SourceMapEntry> CompilerStack::computeSourceMapEntries(eth::AssemblyItems const& _items) const
+{
+	map<string, unsigned> const sourceIndicesMap = sourceIndices();
+	// Consecutive items almost always share the same source name object, so only
+	// look up the index if it changes.
+	string const* lastSourceName = nullptr;
+	int lastSourceIndex = -1;
+	vector<SourceMapEntry> entries;
+	entries.reserve(_items.size());
+	for (auto const& item: _items)
+	{
 		SourceLocation const& location = item.location();
-		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.sourceName && sourceIndicesMap.count(*location.sourceName) ?
-			sourceIndicesMap.at(*location.sourceName) :
-			-1;
-		char jump = '-';
-		if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
-			jump = 'i';
-		else if (item.getJumpType() == eth::AssemblyItem::JumpType::OutOfFunction)
-			jump = 'o';
-
-		unsigned components = 4;
-		if (jump == prevJump)
-		{
-			components--;
-			if (sourceIndex == prevSourceIndex)
-			{
-				components--;
-				if (length == prevLength)
-				{
-					components--;
-					if (location.start == prevStart)
-						components--;
-				}
-			}
-		}
-
-		if (components-- > 0)
+		SourceMapEntry entry;
+		entry.start = location.start;
+		entry.length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+		if (location.sourceName.get() != lastSourceName)
 		{
-			if (location.start != prevStart)
-				ret += std::to_string(location.start);
-			if (components-- > 0)
-			{
-				ret += ':';
-				if (length != prevLength)
-					ret += std::to_string(length);
-				if (components-- > 0)
-				{
-					ret += ':';
-					if (sourceIndex != prevSourceIndex)
-						ret += std::to_string(sourceIndex);
-					if (components-- > 0)
-					{
-						ret += ':';
-						if (jump != prevJump)
-							ret += jump;
-					}
-				}
-			}
+			lastSourceName = location.sourceName.get();
+			auto it = lastSourceName ? sourceIndicesMap.find(*lastSourceName) : sourceIndicesMap.end();
+			lastSourceIndex = it != sourceIndicesMap.end() ? int(it->second) : -1;
 		}
-
-		prevStart = location.start;
-		prevLength = length;
-		prevSourceIndex = sourceIndex;
-		prevJump = jump;
+		entry.sourceIndex = lastSourceIndex;
+		if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
+			entry.jump = 'i';
+		else if (item.getJumpType() == eth::AssemblyItem::JumpType::OutOfFunction)
+			entry.jump = 'o';
+		entries.push_back(entry);
 	}
-	return ret;
+	return entries;
 }
@@ -36,6 +36,7 @@
 #include <libevmasm/SourceLocation.h>
 #include <libevmasm/LinkerObject.h>
 #include <libsolidity/interface/Exceptions.h>
+#include <libsolidity/interface/SourceMap.h>
 
 namespace dev
 {
@@ -45,6 +46,7 @@ namespace eth
 class Assembly;
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
+class ComputeMethodCache;
 }
 
 namespace solidity
@@ -52,11 +54,14 @@ namespace solidity
 
 // forward declarations
 class Scanner;
+class CharStream;
 class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class ParsedSourceCache;
+class TypeProvider;
 class InterfaceHandler;
 class Error;
 
@@ -87,6 +92,7 @@ public:
 	/// Creates a new compiler stack.
 	/// @param _readFile callback to used to read files for import statements. Should return
 	explicit CompilerStack(ReadFileCallback const& _readFile = ReadFileCallback());
+	~CompilerStack();
 
 	/// Sets path remappings in the format "context:prefix=target"
 	void setRemappings(std::vector<std::string> const& _remappings);
@@ -94,6 +100,15 @@ public:
 	/// Resets the compiler to a state where the sources are not parsed or even removed.
 	void reset(bool _keepSources = false);
 
+	/// Sets a cache of parse results that can be shared with other compiler stacks. Sources whose
+	/// name and content are found in the cache are not parsed again, the ASTs of all sources are
+	/// stored in the cache when the compiler stack is reset or destroyed.
+	void setParsedSourceCache(std::shared_ptr<ParsedSourceCache> const& _cache) { m_parsedSourceCache = _cache; }
+
+	/// Sets the maximal number of threads used to parse sources and to type check contracts,
+	/// zero means one thread per core. The results do not depend on the number of threads.
+	void setMaxThreads(unsigned _maxThreads) { m_maxThreads = _maxThreads; }
+
 	/// Adds a source object (e.g. file) to the parser. After this, parse has to be called again.
 	/// @returns true if a source object by the name already existed and was replaced.
 	void addSources(StringMap const& _nameContents, bool _isLibrary = false)
@@ -101,6 +116,10 @@ public:
 		for (auto const& i: _nameContents) addSource(i.first, i.second, _isLibrary);
 	}
 	bool addSource(std::string const& _name, std::string const& _content, bool _isLibrary = false);
+	/// Adds the source @a _source without copying its contents, e.g. a view into a buffer
+	/// owned by the caller or a memory-mapped file (see CharStream).
+	/// @returns true if a source object by the name already existed and was replaced.
+	bool addSource(std::string const& _name, CharStream const& _source, bool _isLibrary = false);
 	void setSource(std::string const& _sourceCode);
 	/// Parses all source units that were added
 	/// @returns false on error.
@@ -148,6 +167,23 @@ public:
 	/// @returns the string that provides a mapping between runtime bytecode and sourcecode.
 	/// if the contract does not (yet) have bytecode.
 	std::string const* runtimeSourceMapping(std::string const& _contractName = "") const;
+	/// @returns the source mapping in the binary format of BinarySourceMap, which allows
+	/// random access by instruction index and by program counter, or a nullptr if the contract
+	/// does not (yet) have bytecode.
+	bytes const* binarySourceMapping(std::string const& _contractName = "") const;
+	/// @returns the runtime source mapping in the binary format of BinarySourceMap or a nullptr
+	/// if the contract does not (yet) have bytecode.
+	bytes const* runtimeBinarySourceMapping(std::string const& _contractName = "") const;
+	/// @returns a table mapping each instruction's offset in the bytecode (program counter) to its
+	/// source location, sorted by offset. Each row is [pc, start, length, sourceIndex, jumpType],
+	/// where sourceIndex refers to sourceNames(). Prerequisite: Successful compilation.
+	Json::Value pcMapping(std::string const& _contractName = "") const;
+	/// @returns the table mapping program counters of the runtime bytecode to source locations.
+	/// Prerequisite: Successful compilation.
+	Json::Value runtimePCMapping(std::string const& _contractName = "") const;
+	/// @returns the positions of the state variables of the contract in storage,
+	/// @see StorageLayout::generate. Prerequisite: Successful call to parse or compile.
+	Json::Value storageLayout(std::string const& _contractName = "") const;
 
 	/// @returns either the contract's name or a mixture of its name and source file, sanitized for filesystem use
 	std::string const filesystemFriendlyName(std::string const& _contractName) const;
@@ -161,7 +197,13 @@ public:
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// @arg _inJsonFromat shows whether the out should be in Json format
 	/// Prerequisite: Successful compilation.
-	Json::Value streamAssembly(std::ostream& _outStream, std::string const& _contractName = "", StringMap _sourceCodes = StringMap(), bool _inJsonFormat = false) const;
+	void streamAssembly(std::ostream& _outStream, std::string const& _contractName = "", StringMap _sourceCodes = StringMap(), bool _inJsonFormat = false) const;
+	/// @returns a JSON representation of the assembly. Prefer streamAssembly for large outputs.
+	/// Prerequisite: Successful compilation.
+	Json::Value assemblyJSON(std::string const& _contractName = "", StringMap _sourceCodes = StringMap()) const;
+	/// Streams the assembly in a compact binary format to @a _outStream.
+	/// Prerequisite: Successful compilation.
+	void streamAssemblyBinary(std::ostream& _outStream, std::string const& _contractName = "") const;
 
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
@@ -178,6 +220,11 @@ public:
 	Json::Value const& metadata(std::string const& _contractName, DocumentationType _type) const;
 	std::string const& onChainMetadata(std::string const& _contractName) const;
 	void useMetadataLiteralSources(bool _metadataLiteralSources) { m_metadataLiteralSources = _metadataLiteralSources; }
+	/// Sets the maximal recursion depth of the optimiser's search for cheap ways to compute constants.
+	void setConstantOptimiserDepth(unsigned _depth) { m_constantOptimiserDepth = _depth; }
+	/// Enables reordering the state variables of each contract to use fewer storage slots,
+	/// see ContractType::stateVariables.
+	void setPackStorage(bool _packStorage) { m_packStorage = _packStorage; }
 
 	/// @returns the previously used scanner, useful for counting lines during error reporting.
 	Scanner const& scanner(std::string const& _sourceName = "") const;
@@ -211,6 +258,11 @@ private:
 		std::shared_ptr<Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
 		bool isLibrary = false;
+		/// Data needed to return the AST to the parsed source cache.
+		h256 contentHash;
+		ErrorList parseErrors;
+		size_t idOffset = 0;
+		size_t lastID = 0;
 		void reset() { scanner.reset(); ast.reset(); }
 	};
 
@@ -227,6 +279,8 @@ private:
 		mutable std::unique_ptr<Json::Value const> devDocumentation;
 		mutable std::unique_ptr<std::string const> sourceMapping;
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
+		mutable std::unique_ptr<bytes const> binarySourceMapping;
+		mutable std::unique_ptr<bytes const> runtimeBinarySourceMapping;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -235,6 +289,8 @@ private:
 	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
+	/// Removes the annotations from all ASTs and moves them into the parsed source cache, if set.
+	void releaseParsedSources();
 	/// @returns the absolute path corresponding to @a _path relative to @a _reference.
 	std::string absolutePath(std::string const& _path, std::string const& _reference) const;
 	/// Helper function to return path converted strings.
@@ -251,7 +307,10 @@ private:
 	Source const& source(std::string const& _sourceName = "") const;
 
 	std::string createOnChainMetadata(Contract const& _contract) const;
-	std::string computeSourceMapping(eth::AssemblyItems const& _items) const;
+	/// @returns the source location and jump type of each of @a _items.
+	std::vector<SourceMapEntry> computeSourceMapEntries(eth::AssemblyItems const& _items) const;
+	/// @returns the program counter to source location table for @a _items assembled into @a _object.
+	Json::Value computePCMapping(eth::AssemblyItems const* _items, eth::LinkerObject const& _object) const;
 	Json::Value const& metadata(Contract const&, DocumentationType _type) const;
 
 	struct Remapping
@@ -264,6 +323,12 @@ private:
 	ReadFileCallback m_readFile;
 	bool m_optimize = false;
 	unsigned m_optimizeRuns = 200;
+	unsigned m_constantOptimiserDepth;
+	bool m_packStorage = false;
+	/// Representations of constants shared by all contracts of the current compilation.
+	std::shared_ptr<eth::ComputeMethodCache> m_constantCache;
+	/// Interned types of the current compilation, created by the analysis.
+	std::shared_ptr<TypeProvider> m_typeProvider;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -276,6 +341,8 @@ private:
 	std::string m_formalTranslation;
 	ErrorList m_errors;
 	bool m_metadataLiteralSources = false;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
+	unsigned m_maxThreads = 0;
 };
 
 }
@@ -128,21 +128,30 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	AssemblyItems const& _items,
 	string const& _signature
 )
+{
+	if (!_signature.empty())
+		return functionalEstimation(_items, FixedHash<4>(dev::keccak256(_signature)));
+
+	PathGasMeter meter(_items);
+	return meter.estimateMax(0, make_shared<KnownState>());
+}
+
+GasEstimator::GasConsumption GasEstimator::functionalEstimation(
+	AssemblyItems const& _items,
+	FixedHash<4> const& _selector
+)
 {
 	auto state = make_shared<KnownState>();
 
-	if (!_signature.empty())
-	{
-		ExpressionClasses& classes = state->expressionClasses();
-		using Id = ExpressionClasses::Id;
-		using Ids = vector<Id>;
-		Id hashValue = classes.find(u256(FixedHash<4>::Arith(FixedHash<4>(dev::keccak256(_signature)))));
-		Id calldata = classes.find(Instruction::CALLDATALOAD, Ids{classes.find(u256(0))});
-		classes.forceEqual(hashValue, Instruction::DIV, Ids{
-			calldata,
-			classes.find(u256(1) << (8 * 28))
-		});
-	}
+	ExpressionClasses& classes = state->expressionClasses();
+	using Id = ExpressionClasses::Id;
+	using Ids = vector<Id>;
+	Id hashValue = classes.find(u256(FixedHash<4>::Arith(_selector)));
+	Id calldata = classes.find(Instruction::CALLDATALOAD, Ids{classes.find(u256(0))});
+	classes.forceEqual(hashValue, Instruction::DIV, Ids{
+		calldata,
+		classes.find(u256(1) << (8 * 28))
+	});
 
 	PathGasMeter meter(_items);
 	return meter.estimateMax(0, state);
@@ -27,6 +27,7 @@
 #include <array>
 #include <libevmasm/GasMeter.h>
 #include <libevmasm/Assembly.h>
+#include <libdevcore/FixedHash.h>
 
 namespace dev
 {
@@ -67,6 +68,13 @@ public:
 		std::string const& _signature = ""
 	);
 
+	/// @returns the estimated gas consumption by the (public or external) function with the
+	/// given selector (first four bytes of the hash of the signature).
+	static GasConsumption functionalEstimation(
+		eth::AssemblyItems const& _items,
+		FixedHash<4> const& _selector
+	);
+
 	/// @returns the estimated gas consumption by the given function which starts at the given
 	/// offset into the list of assembly items.
 	/// @note this does not work correctly for recursive functions.
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Cache of parse results that can be shared between compiler stacks.
+ */
+
+#include <libsolidity/interface/ParsedSourceCache.h>
+#include <libsolidity/ast/AST.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+size_t const ParsedSourceCache::defaultMaxEntries = 16;
+
+ParsedSource ParsedSourceCache::take(string const& _name, h256 const& _hash)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_index.find(make_pair(_name, _hash));
+	if (it == m_index.end())
+		return ParsedSource();
+	ParsedSource ret = move(it->second->second);
+	m_entries.erase(it->second);
+	m_index.erase(it);
+	return ret;
+}
+
+void ParsedSourceCache::store(string const& _name, h256 const& _hash, ParsedSource _source)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (m_maxEntries == 0)
+		return;
+	Key key(_name, _hash);
+	auto it = m_index.find(key);
+	if (it != m_index.end())
+		m_entries.erase(it->second);
+	else if (m_entries.size() >= m_maxEntries)
+	{
+		m_index.erase(m_entries.back().first);
+		m_entries.pop_back();
+	}
+	m_entries.emplace_front(key, move(_source));
+	m_index[key] = m_entries.begin();
+}
+
+size_t ParsedSourceCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+void ParsedSourceCache::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_index.clear();
+	m_entries.clear();
+}
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Cache of parse results that can be shared between compiler stacks.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/interface/Exceptions.h>
+#include <libdevcore/FixedHash.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/// Result of parsing a single source.
+struct ParsedSource
+{
+	ASTPointer<SourceUnit> ast;
+	/// Errors and warnings reported by the parser.
+	ErrorList errors;
+	/// ID of the last node created while parsing, node IDs start at one for each source.
+	size_t lastID = 0;
+};
+
+/**
+ * Thread-safe cache of parsed sources, keyed by source name and keccak256 hash of the contents.
+ * Since the analysis annotates the AST, an entry is removed from the cache while a compiler
+ * stack uses it and stored again (without annotations) once the compiler stack is done with it.
+ * Each entry keeps a whole AST alive, so the number of entries is limited.
+ */
+class ParsedSourceCache
+{
+public:
+	static size_t const defaultMaxEntries;
+
+	explicit ParsedSourceCache(size_t _maxEntries = defaultMaxEntries): m_maxEntries(_maxEntries) {}
+
+	/// Removes the entry for the given source from the cache.
+	/// @returns the entry or an entry without AST if the source is not cached.
+	ParsedSource take(std::string const& _name, h256 const& _hash);
+	/// Stores the unannotated parse result @a _source. Evicts the least recently stored entry
+	/// if the cache is full. As entries are taken out while they are used, this is the least
+	/// recently used one.
+	void store(std::string const& _name, h256 const& _hash, ParsedSource _source);
+
+	size_t size() const;
+	void clear();
+
+private:
+	using Key = std::pair<std::string, h256>;
+
+	mutable std::mutex m_mutex;
+	size_t m_maxEntries;
+	/// Entries, most recently stored first.
+	std::list<std::pair<Key, ParsedSource>> m_entries;
+	std::map<Key, std::list<std::pair<Key, ParsedSource>>::iterator> m_index;
+};
+
+}
+}
@@ -0,0 +1,301 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Source mappings between assembly items and source code, in the textual "s:l:f:j"
+ * format and in a compact binary format that supports random access.
+ */
+
+#include <libsolidity/interface/SourceMap.h>
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+// Binary format (all varints are unsigned LEB128, see appendVarint):
+//   "SMAP" version:byte(1) entryCount:varint blockSize:varint
+//   for each block: blockOffset:uint32 blockPC:uint32 (both big endian), where the offset is
+//   relative to the start of the entries and the program counter is that of the first entry
+//   entries
+// Each entry starts with a flags byte: bits 0-2 are set if start, length or source index
+// follow (as varints of the value plus one), bits 3-4 hold the jump type (0: '-', 1: 'i', 2: 'o').
+// Components without their flag bit are equal to those of the previous entry in the block,
+// the first entry of a block always contains all of them. The entry ends with the difference
+// between its program counter and that of the previous entry in the block (varint).
+
+namespace
+{
+
+size_t const c_headerSize = 5;
+unsigned const c_version = 1;
+size_t const c_blockTableEntrySize = 8;
+
+void writeUint32(bytes& _out, size_t _pos, size_t _value)
+{
+	if (_value > 0xffffffff)
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Source map too large."));
+	for (size_t i = 0; i < 4; ++i)
+		_out[_pos + i] = byte(_value >> (8 * (3 - i)));
+}
+
+size_t readUint32(bytesConstRef _data, size_t _pos)
+{
+	size_t ret = 0;
+	for (size_t i = 0; i < 4; ++i)
+		ret = (ret << 8) | _data[_pos + i];
+	return ret;
+}
+
+enum SourceMapFlags: byte
+{
+	HasStart = 1,
+	HasLength = 2,
+	HasSourceIndex = 4,
+	JumpShift = 3
+};
+
+void appendInt(string& _out, int _value)
+{
+	if (_value < 0)
+	{
+		_out += '-';
+		_value = -_value;
+	}
+	char digits[12];
+	size_t n = 0;
+	do
+		digits[n++] = char('0' + _value % 10);
+	while (_value /= 10);
+	while (n > 0)
+		_out += digits[--n];
+}
+
+}
+
+unsigned const BinarySourceMap::defaultBlockSize = 64;
+
+string dev::solidity::compressSourceMapping(vector<SourceMapEntry> const& _entries)
+{
+	string ret;
+	// Most entries only consist of the separator or differ in their start offset.
+	ret.reserve(_entries.size() * 4);
+	SourceMapEntry prev;
+	prev.jump = 0;
+	for (auto const& entry: _entries)
+	{
+		if (&entry != &_entries.front())
+			ret += ';';
+
+		unsigned components = 4;
+		if (entry.jump == prev.jump)
+		{
+			components--;
+			if (entry.sourceIndex == prev.sourceIndex)
+			{
+				components--;
+				if (entry.length == prev.length)
+				{
+					components--;
+					if (entry.start == prev.start)
+						components--;
+				}
+			}
+		}
+
+		if (components-- > 0)
+		{
+			if (entry.start != prev.start)
+				appendInt(ret, entry.start);
+			if (components-- > 0)
+			{
+				ret += ':';
+				if (entry.length != prev.length)
+					appendInt(ret, entry.length);
+				if (components-- > 0)
+				{
+					ret += ':';
+					if (entry.sourceIndex != prev.sourceIndex)
+						appendInt(ret, entry.sourceIndex);
+					if (components-- > 0)
+					{
+						ret += ':';
+						if (entry.jump != prev.jump)
+							ret += entry.jump;
+					}
+				}
+			}
+		}
+
+		prev = entry;
+	}
+	return ret;
+}
+
+bytes BinarySourceMap::encode(
+	vector<SourceMapEntry> const& _entries,
+	vector<size_t> const& _programCounters,
+	unsigned _blockSize
+)
+{
+	if (_blockSize == 0)
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Block size must not be zero."));
+	if (_programCounters.size() != _entries.size())
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Number of program counters and entries differ."));
+	size_t blocks = (_entries.size() + _blockSize - 1) / _blockSize;
+
+	bytes ret{'S', 'M', 'A', 'P', byte(c_version)};
+	appendVarint(_entries.size(), ret);
+	appendVarint(_blockSize, ret);
+	size_t blockTable = ret.size();
+	ret.resize(blockTable + c_blockTableEntrySize * blocks);
+	size_t entriesStart = ret.size();
+	// Most entries need the flags byte, a short start offset and a one byte program counter difference.
+	ret.reserve(entriesStart + _entries.size() * 4);
+
+	SourceMapEntry prev;
+	size_t prevPC = 0;
+	for (size_t i = 0; i < _entries.size(); ++i)
+	{
+		SourceMapEntry const& entry = _entries[i];
+		size_t pc = _programCounters[i];
+		bool blockStart = i % _blockSize == 0;
+		if (blockStart)
+		{
+			size_t tablePos = blockTable + c_blockTableEntrySize * (i / _blockSize);
+			writeUint32(ret, tablePos, ret.size() - entriesStart);
+			writeUint32(ret, tablePos + 4, pc);
+			prevPC = pc;
+		}
+		if (pc < prevPC)
+			BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Program counters not sorted."));
+		byte flags = byte((entry.jump == 'i' ? 1 : entry.jump == 'o' ? 2 : 0) << JumpShift);
+		if (blockStart || entry.start != prev.start)
+			flags |= HasStart;
+		if (blockStart || entry.length != prev.length)
+			flags |= HasLength;
+		if (blockStart || entry.sourceIndex != prev.sourceIndex)
+			flags |= HasSourceIndex;
+		ret.push_back(flags);
+		if (flags & HasStart)
+			appendVarint(unsigned(entry.start + 1), ret);
+		if (flags & HasLength)
+			appendVarint(unsigned(entry.length + 1), ret);
+		if (flags & HasSourceIndex)
+			appendVarint(unsigned(entry.sourceIndex + 1), ret);
+		appendVarint(pc - prevPC, ret);
+		prev = entry;
+		prevPC = pc;
+	}
+	return ret;
+}
+
+BinarySourceMap::BinarySourceMap(bytesConstRef _data):
+	m_data(_data)
+{
+	if (
+		m_data.size() < c_headerSize ||
+		m_data.cropped(0, 4).toString() != "SMAP" ||
+		m_data[4] != c_version
+	)
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Invalid source map header."));
+	size_t pos = c_headerSize;
+	m_size = readVarint<size_t>(m_data, pos);
+	m_blockSize = readVarint<size_t>(m_data, pos);
+	if (m_blockSize == 0)
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Invalid source map block size."));
+	m_blocks = m_size / m_blockSize + (m_size % m_blockSize ? 1 : 0);
+	m_blockTable = pos;
+	if (m_blocks > (m_data.size() - m_blockTable) / c_blockTableEntrySize)
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Truncated source map block table."));
+	m_entries = m_blockTable + c_blockTableEntrySize * m_blocks;
+}
+
+SourceMapEntry BinarySourceMap::at(size_t _instruction) const
+{
+	if (_instruction >= m_size)
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Instruction index out of range."));
+	SourceMapEntry entry;
+	decodeBlock(_instruction / m_blockSize, [&](size_t _index, size_t, SourceMapEntry const& _entry)
+	{
+		entry = _entry;
+		return _index < _instruction;
+	});
+	return entry;
+}
+
+size_t BinarySourceMap::instructionAt(size_t _pc) const
+{
+	if (m_size == 0 || _pc < blockPC(0))
+		BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Program counter out of range."));
+	// Binary search for the last block that starts at or before _pc.
+	size_t low = 0;
+	size_t high = m_blocks;
+	while (high - low > 1)
+	{
+		size_t middle = low + (high - low) / 2;
+		if (blockPC(middle) <= _pc)
+			low = middle;
+		else
+			high = middle;
+	}
+	size_t instruction = low * m_blockSize;
+	decodeBlock(low, [&](size_t _index, size_t _entryPC, SourceMapEntry const&)
+	{
+		if (_entryPC > _pc)
+			return false;
+		instruction = _index;
+		return true;
+	});
+	return instruction;
+}
+
+size_t BinarySourceMap::blockPC(size_t _block) const
+{
+	return readUint32(m_data, m_blockTable + c_blockTableEntrySize * _block + 4);
+}
+
+void BinarySourceMap::decodeBlock(
+	size_t _block,
+	function<bool(size_t, size_t, SourceMapEntry const&)> const& _visitor
+) const
+{
+	size_t pos = m_entries + readUint32(m_data, m_blockTable + c_blockTableEntrySize * _block);
+	size_t pc = blockPC(_block);
+	SourceMapEntry entry;
+	for (size_t i = _block * m_blockSize; i < min(m_size, (_block + 1) * m_blockSize); ++i)
+	{
+		if (pos >= m_data.size())
+			BOOST_THROW_EXCEPTION(InvalidSourceMap() << errinfo_comment("Truncated source map."));
+		byte flags = m_data[pos++];
+		if (flags & HasStart)
+			entry.start = int(readVarint<unsigned>(m_data, pos)) - 1;
+		if (flags & HasLength)
+			entry.length = int(readVarint<unsigned>(m_data, pos)) - 1;
+		if (flags & HasSourceIndex)
+			entry.sourceIndex = int(readVarint<unsigned>(m_data, pos)) - 1;
+		switch (flags >> JumpShift)
+		{
+		case 1: entry.jump = 'i'; break;
+		case 2: entry.jump = 'o'; break;
+		default: entry.jump = '-';
+		}
+		pc += readVarint<size_t>(m_data, pos);
+		if (!_visitor(i, pc, entry))
+			break;
+	}
+}
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Source mappings between assembly items and source code, in the textual "s:l:f:j"
+ * format and in a compact binary format that supports random access.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <libdevcore/Common.h>
+#include <libdevcore/Exceptions.h>
+
+namespace dev
+{
+namespace solidity
+{
+
+DEV_SIMPLE_EXCEPTION(InvalidSourceMap);
+
+/// Source location and jump type of a single assembly item (i.e. instruction).
+/// Unknown values are represented by -1.
+struct SourceMapEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	/// One of '-' (regular), 'i' (jump into function) and 'o' (jump out of function).
+	char jump = '-';
+
+	bool operator==(SourceMapEntry const& _other) const
+	{
+		return
+			start == _other.start &&
+			length == _other.length &&
+			sourceIndex == _other.sourceIndex &&
+			jump == _other.jump;
+	}
+	bool operator!=(SourceMapEntry const& _other) const { return !operator==(_other); }
+};
+
+/// @returns the compressed textual source mapping "s:l:f:j;s:l:f:j;..." where components
+/// that equal those of the previous entry are omitted.
+std::string compressSourceMapping(std::vector<SourceMapEntry> const& _entries);
+
+/**
+ * Binary encoding of a source mapping together with the program counter (bytecode offset) of
+ * each instruction. The entries are grouped into blocks of a fixed size, each entry only stores
+ * the components that differ from the previous entry in the same block and a table of block
+ * offsets and program counters allows to decode a single entry, by instruction index or by
+ * program counter, without reading the whole map.
+ */
+class BinarySourceMap
+{
+public:
+	static unsigned const defaultBlockSize;
+
+	/// @returns the binary encoding of @a _entries, where @a _programCounters contains the
+	/// (ascending) offset in the bytecode of each entry's instruction.
+	static bytes encode(
+		std::vector<SourceMapEntry> const& _entries,
+		std::vector<size_t> const& _programCounters,
+		unsigned _blockSize = defaultBlockSize
+	);
+
+	/// Creates a reader for the encoded map @a _data, which has to outlive the reader.
+	/// @throws InvalidSourceMap if the header or the block table is malformed.
+	explicit BinarySourceMap(bytesConstRef _data);
+
+	/// @returns the number of entries (instructions) in the map.
+	size_t size() const { return m_size; }
+	/// @returns the entry for the instruction with index @a _instruction.
+	SourceMapEntry at(size_t _instruction) const;
+	/// @returns the index of the instruction whose code contains the program counter @a _pc,
+	/// i.e. the last instruction that starts at or before @a _pc.
+	/// @throws InvalidSourceMap if @a _pc is before the first instruction.
+	size_t instructionAt(size_t _pc) const;
+	/// @returns the entry for the instruction whose code contains the program counter @a _pc.
+	SourceMapEntry atProgramCounter(size_t _pc) const { return at(instructionAt(_pc)); }
+
+private:
+	/// @returns the program counter of the first entry of block @a _block.
+	size_t blockPC(size_t _block) const;
+	/// Decodes the entries of block @a _block and calls @a _visitor with the index, program
+	/// counter and source map entry of each of them until it returns false.
+	void decodeBlock(size_t _block, std::function<bool(size_t, size_t, SourceMapEntry const&)> const& _visitor) const;
+
+	bytesConstRef m_data;
+	size_t m_size = 0;
+	size_t m_blockSize = 0;
+	size_t m_blocks = 0;
+	/// Position of the block offset table inside m_data.
+	size_t m_blockTable = 0;
+	/// Position of the first entry inside m_data.
+	size_t m_entries = 0;
+};
+
+}
+}
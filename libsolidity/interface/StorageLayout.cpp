@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Generates a JSON description of the positions of the state variables of a contract in storage.
+ */
+
+#include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+Json::Value StorageLayout::generate(ContractDefinition const& _contract, bool _packed)
+{
+	auto variables = ContractType(_contract).stateVariables(_packed);
+	stable_sort(variables.begin(), variables.end(), [](
+		tuple<VariableDeclaration const*, u256, unsigned> const& _a,
+		tuple<VariableDeclaration const*, u256, unsigned> const& _b
+	)
+	{
+		return make_pair(get<1>(_a), get<2>(_a)) < make_pair(get<1>(_b), get<2>(_b));
+	});
+
+	Json::Value layout(Json::objectValue);
+	layout["storage"] = Json::arrayValue;
+	layout["types"] = Json::objectValue;
+	for (auto const& variable: variables)
+	{
+		VariableDeclaration const& declaration = *get<0>(variable);
+		layout["storage"].append(variableEntry(
+			declaration,
+			declaration.annotation().type,
+			get<1>(variable),
+			get<2>(variable),
+			layout["types"]
+		));
+	}
+	return layout;
+}
+
+Json::Value StorageLayout::variableEntry(
+	VariableDeclaration const& _variable,
+	TypePointer const& _type,
+	u256 const& _slot,
+	unsigned _offset,
+	Json::Value& _types
+)
+{
+	Json::Value entry(Json::objectValue);
+	entry["astId"] = Json::UInt64(_variable.id());
+	if (auto const* contract = dynamic_cast<ContractDefinition const*>(_variable.scope()))
+		entry["contract"] = contract->fullyQualifiedName();
+	entry["label"] = _variable.name();
+	entry["offset"] = _offset;
+	entry["slot"] = _slot.str();
+	entry["type"] = addType(_type, _types);
+	return entry;
+}
+
+string StorageLayout::addType(TypePointer const& _type, Json::Value& _types)
+{
+	string identifier = _type->identifier();
+	if (_types.isMember(identifier))
+		return identifier;
+
+	Json::Value& entry = _types[identifier];
+	entry["label"] = _type->toString(true);
+	if (_type->storageSize() == 1 && _type->storageBytes() < 32)
+		entry["numberOfBytes"] = to_string(_type->storageBytes());
+	else
+		entry["numberOfBytes"] = (_type->storageSize() * 32).str();
+
+	// The entry is created before the referenced types are added, so that recursive
+	// structs terminate.
+	if (auto mapping = dynamic_cast<MappingType const*>(_type.get()))
+	{
+		entry["encoding"] = "mapping";
+		entry["key"] = addType(mapping->keyType(), _types);
+		entry["value"] = addType(mapping->valueType(), _types);
+	}
+	else if (auto array = dynamic_cast<ArrayType const*>(_type.get()))
+	{
+		if (array->isByteArray())
+			entry["encoding"] = "bytes";
+		else
+		{
+			entry["encoding"] = array->isDynamicallySized() ? "dynamic_array" : "inplace";
+			entry["base"] = addType(array->baseType(), _types);
+		}
+	}
+	else if (auto structType = dynamic_cast<StructType const*>(_type.get()))
+	{
+		entry["encoding"] = "inplace";
+		entry["members"] = Json::arrayValue;
+		for (auto const& member: structType->members(nullptr))
+		{
+			auto const& offsets = structType->storageOffsetsOfMember(member.name);
+			auto const* declaration = dynamic_cast<VariableDeclaration const*>(member.declaration);
+			solAssert(declaration, "Struct member without declaration.");
+			entry["members"].append(variableEntry(*declaration, member.type, offsets.first, offsets.second, _types));
+		}
+	}
+	else
+		entry["encoding"] = "inplace";
+	return identifier;
+}
@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Generates a JSON description of the positions of the state variables of a contract in storage.
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <json/json.h>
+#include <memory>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+class ContractDefinition;
+class VariableDeclaration;
+class Type;
+using TypePointer = std::shared_ptr<Type const>;
+
+class StorageLayout
+{
+public:
+	/// @returns the storage layout of @a _contract, including the state variables of its base
+	/// contracts, as {"storage": [variable, ...], "types": {typeIdentifier: type, ...}}.
+	/// The variables are sorted by position and have the keys "astId", "contract", "label",
+	/// "offset", "slot" and "type", where "type" refers to an entry in "types". Each type has
+	/// the keys "encoding" (one of "inplace", "mapping", "dynamic_array" and "bytes"), "label" and
+	/// "numberOfBytes", structs additionally have "members" (relative to the slot of the struct,
+	/// in the same format as "storage"), mappings "key" and "value" and arrays "base".
+	/// Slots and sizes are decimal strings since they can exceed 64 bits.
+	/// @param _packed if true, the layout produced by the storage packing option is returned.
+	static Json::Value generate(ContractDefinition const& _contract, bool _packed = false);
+
+private:
+	/// @returns the entry for the variable @a _variable of type @a _type at the given position
+	/// and adds its type to @a _types.
+	static Json::Value variableEntry(
+		VariableDeclaration const& _variable,
+		TypePointer const& _type,
+		u256 const& _slot,
+		unsigned _offset,
+		Json::Value& _types
+	);
+	/// Adds @a _type and all types it refers to to @a _types and @returns its identifier.
+	static std::string addType(TypePointer const& _type, Json::Value& _types);
+};
+
+}
+}
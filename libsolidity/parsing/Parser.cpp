@@ -57,7 +57,7 @@ public:
 	{
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_location, forward<Args>(_args)...);
+		return makeArenaObject<NodeType>(m_parser.m_arena, m_location, forward<Args>(_args)...);
 	}
 
 private:
@@ -70,6 +70,7 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	try
 	{
 		m_scanner = _scanner;
+		m_identifiers.clear();
 		ASTNodeFactory nodeFactory(*this);
 		vector<ASTPointer<ASTNode>> nodes;
 		while (m_scanner->currentToken() != Token::EOS)
@@ -138,7 +139,7 @@ ASTPointer<ImportDirective> Parser::parseImportDirective()
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Import);
 	ASTPointer<ASTString> path;
-	ASTPointer<ASTString> unitAlias = make_shared<string>();
+	ASTPointer<ASTString> unitAlias = makeArenaObject<ASTString>(m_arena);
 	vector<pair<ASTPointer<Identifier>, ASTPointer<ASTString>>> symbolAliases;
 
 	if (m_scanner->currentToken() == Token::StringLiteral)
@@ -198,7 +199,7 @@ ASTPointer<ContractDefinition> Parser::parseContractDefinition(bool _isLibrary)
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docString;
 	if (m_scanner->currentCommentLiteral() != "")
-		docString = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docString = makeArenaObject<ASTString>(m_arena, m_scanner->currentCommentLiteral());
 	expectToken(_isLibrary ? Token::Library : Token::Contract);
 	ASTPointer<ASTString> name = expectIdentifierToken();
 	vector<ASTPointer<InheritanceSpecifier>> baseContracts;
@@ -295,7 +296,7 @@ Parser::FunctionHeaderParserResult Parser::parseFunctionHeader(bool _forceEmptyN
 	FunctionHeaderParserResult result;
 	expectToken(Token::Function);
 	if (_forceEmptyName || m_scanner->currentToken() == Token::LParen)
-		result.name = make_shared<ASTString>(); // anonymous function
+		result.name = makeArenaObject<ASTString>(m_arena); // anonymous function
 	else
 		result.name = expectIdentifierToken();
 	VarDeclParserOptions options;
@@ -352,7 +353,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinitionOrFunctionTypeStateVariable(A
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docstring;
 	if (m_scanner->currentCommentLiteral() != "")
-		docstring = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docstring = makeArenaObject<ASTString>(m_arena, m_scanner->currentCommentLiteral());
 
 	FunctionHeaderParserResult header = parseFunctionHeader(false, true);
 
@@ -514,7 +515,7 @@ ASTPointer<VariableDeclaration> Parser::parseVariableDeclaration(
 
 	if (_options.allowEmptyName && m_scanner->currentToken() != Token::Identifier)
 	{
-		identifier = make_shared<ASTString>("");
+		identifier = makeArenaObject<ASTString>(m_arena, "");
 		solAssert(type != nullptr, "");
 		nodeFactory.setEndPositionFromNode(type);
 	}
@@ -550,7 +551,7 @@ ASTPointer<ModifierDefinition> Parser::parseModifierDefinition()
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docstring;
 	if (m_scanner->currentCommentLiteral() != "")
-		docstring = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docstring = makeArenaObject<ASTString>(m_arena, m_scanner->currentCommentLiteral());
 
 	expectToken(Token::Modifier);
 	ASTPointer<ASTString> name(expectIdentifierToken());
@@ -574,7 +575,7 @@ ASTPointer<EventDefinition> Parser::parseEventDefinition()
 	ASTNodeFactory nodeFactory(*this);
 	ASTPointer<ASTString> docstring;
 	if (m_scanner->currentCommentLiteral() != "")
-		docstring = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docstring = makeArenaObject<ASTString>(m_arena, m_scanner->currentCommentLiteral());
 
 	expectToken(Token::Event);
 	ASTPointer<ASTString> name(expectIdentifierToken());
@@ -779,7 +780,7 @@ ASTPointer<Statement> Parser::parseStatement()
 {
 	ASTPointer<ASTString> docString;
 	if (m_scanner->currentCommentLiteral() != "")
-		docString = make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docString = makeArenaObject<ASTString>(m_arena, m_scanner->currentCommentLiteral());
 	ASTPointer<Statement> statement;
 	switch (m_scanner->currentToken())
 	{
@@ -1238,7 +1239,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		break;
 	case Token::Identifier:
 		nodeFactory.markEndPosition();
-		expression = nodeFactory.createNode<Identifier>(getLiteralAndAdvance());
+		expression = nodeFactory.createNode<Identifier>(expectIdentifierToken());
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -1402,7 +1403,7 @@ ASTPointer<Expression> Parser::expressionFromIndexAccessStructure(
 		Identifier const& identifier = dynamic_cast<Identifier const&>(*_path[i]);
 		expression = nodeFactory.createNode<MemberAccess>(
 			expression,
-			make_shared<ASTString>(identifier.name())
+			internIdentifier(identifier.name())
 		);
 	}
 	for (auto const& index: _indices)
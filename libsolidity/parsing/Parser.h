@@ -35,7 +35,9 @@ class Scanner;
 class Parser: public ParserBase
 {
 public:
-	Parser(ErrorList& _errors): ParserBase(_errors) {}
+	/// Nodes are allocated from @a _arena if it is set.
+	Parser(ErrorList& _errors, std::shared_ptr<ASTArena> _arena = nullptr):
+		ParserBase(_errors, std::move(_arena)) {}
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<Scanner> const& _scanner);
 
@@ -22,6 +22,7 @@
 
 #include <libsolidity/parsing/ParserBase.h>
 #include <libsolidity/parsing/Scanner.h>
+#include <boost/functional/hash.hpp>
 
 using namespace std;
 using namespace dev;
@@ -126,16 +127,39 @@ ASTPointer<ASTString> ParserBase::expectIdentifierToken()
 				string("'")
 			);
 	}
-	return getLiteralAndAdvance();
+	ASTPointer<ASTString> identifier = internIdentifier(m_scanner->currentLiteral());
+	m_scanner->next();
+	return identifier;
 }
 
 ASTPointer<ASTString> ParserBase::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = makeArenaObject<ASTString>(m_arena, m_scanner->currentLiteral());
 	m_scanner->next();
 	return identifier;
 }
 
+ASTPointer<ASTString> ParserBase::internIdentifier(string const& _name)
+{
+	auto it = m_identifiers.find(vector_ref<char const>(_name));
+	if (it != m_identifiers.end())
+		return it->second;
+	ASTPointer<ASTString> identifier = makeArenaObject<ASTString>(m_arena, _name);
+	// Strings are never modified after parsing, so the view of their characters stays valid.
+	m_identifiers.emplace(vector_ref<char const>(*identifier), identifier);
+	return identifier;
+}
+
+size_t ParserBase::StringViewHash::operator()(vector_ref<char const> _view) const
+{
+	return boost::hash_range(_view.begin(), _view.end());
+}
+
+bool ParserBase::StringViewEqual::operator()(vector_ref<char const> _a, vector_ref<char const> _b) const
+{
+	return _a.size() == _b.size() && equal(_a.begin(), _a.end(), _b.begin());
+}
+
 void ParserBase::parserError(string const& _description)
 {
 	auto err = make_shared<Error>(Error::Type::ParserError);
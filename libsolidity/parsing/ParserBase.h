@@ -23,9 +23,12 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
+#include <libdevcore/vector_ref.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/parsing/Token.h>
 #include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/ast/ASTArena.h>
 
 namespace dev
 {
@@ -37,7 +40,8 @@ class Scanner;
 class ParserBase
 {
 public:
-	ParserBase(ErrorList& errors): m_errors(errors) {}
+	ParserBase(ErrorList& errors, std::shared_ptr<ASTArena> _arena = nullptr):
+		m_arena(std::move(_arena)), m_errors(errors) {}
 
 	std::shared_ptr<std::string const> const& sourceName() const;
 
@@ -55,6 +59,9 @@ protected:
 	Token::Value expectAssignmentOperator();
 	ASTPointer<ASTString> expectIdentifierToken();
 	ASTPointer<ASTString> getLiteralAndAdvance();
+	/// @returns the canonical string object for the identifier @a _name, so that all
+	/// occurrences of an identifier share the same string.
+	ASTPointer<ASTString> internIdentifier(std::string const& _name);
 	///@}
 
 	/// Creates a @ref ParserError and annotates it with the current position and the
@@ -66,6 +73,15 @@ protected:
 	void fatalParserError(std::string const& _description);
 
 	std::shared_ptr<Scanner> m_scanner;
+	/// Memory area for the AST nodes and strings created by the parser, nodes are allocated
+	/// on the heap if it is not set.
+	std::shared_ptr<ASTArena> m_arena;
+	/// Hashes and compares the characters of string views.
+	struct StringViewHash { size_t operator()(vector_ref<char const> _view) const; };
+	struct StringViewEqual { bool operator()(vector_ref<char const> _a, vector_ref<char const> _b) const; };
+	/// Identifiers encountered by this parser so far, see internIdentifier. The keys are views
+	/// of the interned strings themselves, so each name is only stored once.
+	std::unordered_map<vector_ref<char const>, ASTPointer<ASTString>, StringViewHash, StringViewEqual> m_identifiers;
 	/// The reference to the list of errors and warning to add errors/warnings during parsing
 	ErrorList& m_errors;
 };
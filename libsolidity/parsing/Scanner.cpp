@@ -54,6 +54,7 @@
 #include <tuple>
 #include <libsolidity/interface/Utils.h>
 #include <libsolidity/parsing/Scanner.h>
+#include <libdevcore/CommonIO.h>
 
 using namespace std;
 
@@ -64,15 +65,47 @@ namespace solidity
 
 namespace
 {
+enum CharClass: uint8_t
+{
+	DecimalDigit = 1,
+	HexDigit = 2,
+	IdentifierStart = 4,
+	WhiteSpace = 8
+};
+
+constexpr uint8_t charClassOf(unsigned c)
+{
+	return
+		(('0' <= c && c <= '9') ? (DecimalDigit | HexDigit) : 0) |
+		((('a' <= c && c <= 'f') || ('A' <= c && c <= 'F')) ? HexDigit : 0) |
+		((c == '_' || c == '$' || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z')) ? IdentifierStart : 0) |
+		((c == ' ' || c == '\n' || c == '\t' || c == '\r') ? WhiteSpace : 0);
+}
+
+/// Character classes of all 256 character values, computed at compile time, so that the hot
+/// loops of the scanner only need a single lookup per character.
+#define SOL_CHAR_CLASSES_4(c) charClassOf(c), charClassOf(c + 1), charClassOf(c + 2), charClassOf(c + 3)
+#define SOL_CHAR_CLASSES_16(c) SOL_CHAR_CLASSES_4(c), SOL_CHAR_CLASSES_4(c + 4), SOL_CHAR_CLASSES_4(c + 8), SOL_CHAR_CLASSES_4(c + 12)
+#define SOL_CHAR_CLASSES_64(c) SOL_CHAR_CLASSES_16(c), SOL_CHAR_CLASSES_16(c + 16), SOL_CHAR_CLASSES_16(c + 32), SOL_CHAR_CLASSES_16(c + 48)
+uint8_t const c_charClasses[256] = {
+	SOL_CHAR_CLASSES_64(0), SOL_CHAR_CLASSES_64(64), SOL_CHAR_CLASSES_64(128), SOL_CHAR_CLASSES_64(192)
+};
+#undef SOL_CHAR_CLASSES_64
+#undef SOL_CHAR_CLASSES_16
+#undef SOL_CHAR_CLASSES_4
+
+bool hasCharClass(char c, uint8_t _classes)
+{
+	return (c_charClasses[uint8_t(c)] & _classes) != 0;
+}
+
 bool isDecimalDigit(char c)
 {
-	return '0' <= c && c <= '9';
+	return hasCharClass(c, DecimalDigit);
 }
 bool isHexDigit(char c)
 {
-	return isDecimalDigit(c)
-		   || ('a' <= c && c <= 'f')
-		   || ('A' <= c && c <= 'F');
+	return hasCharClass(c, HexDigit);
 }
 bool isLineTerminator(char c)
 {
@@ -80,15 +113,15 @@ bool isLineTerminator(char c)
 }
 bool isWhiteSpace(char c)
 {
-	return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+	return hasCharClass(c, WhiteSpace);
 }
 bool isIdentifierStart(char c)
 {
-	return c == '_' || c == '$' || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+	return hasCharClass(c, IdentifierStart);
 }
 bool isIdentifierPart(char c)
 {
-	return isIdentifierStart(c) || isDecimalDigit(c);
+	return hasCharClass(c, IdentifierStart | DecimalDigit);
 }
 int hexValue(char c)
 {
@@ -798,12 +831,40 @@ tuple<Token::Value, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char)) //get full literal
-		addLiteralCharAndAdvance();
+	size_t start = m_source.position();
+	// Identifiers do not contain escapes, so the literal can be taken from the source in one go.
+	while (isIdentifierPart(m_char))
+		advance();
+	vector_ref<char const> source = m_source.source();
+	size_t end = min<size_t>(m_source.position(), source.size());
+	m_nextToken.literal.assign(source.data() + start, end - start);
 	literal.complete();
-	return Token::fromIdentifierOrKeyword(m_nextToken.literal);
+	return Token::fromIdentifierOrKeyword(source.data() + start, source.data() + end);
+}
+
+CharStream::CharStream(string const& _source):
+	CharStream(make_shared<string const>(_source))
+{
+}
+
+CharStream::CharStream(shared_ptr<string const> const& _source):
+	m_owner(_source),
+	m_data(_source->data()),
+	m_size(_source->size())
+{
+}
+
+CharStream::CharStream(char const* _data, size_t _size, shared_ptr<void const> const& _owner):
+	m_owner(_owner),
+	m_data(_data),
+	m_size(_size)
+{
+}
+
+CharStream CharStream::fromFile(string const& _path)
+{
+	auto file = make_shared<MappedFile>(_path);
+	return CharStream(file->data(), file->size(), file);
 }
 
 char CharStream::advanceAndGet(size_t _chars)
@@ -813,7 +874,7 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return m_data[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -826,35 +887,36 @@ char CharStream::rollback(size_t _amount)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	return m_source.substr(lineStart, min(m_source.find('\n', lineStart),
-										  m_source.size()) - lineStart);
+	vector<size_t> const& starts = lineStarts();
+	size_t line = lineOfPosition(min<size_t>(m_size, max(_position, 0)));
+	size_t lineEnd = line + 1 < starts.size() ? starts[line + 1] - 1 : m_size;
+	return string(m_data + starts[line], m_data + lineEnd);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	size_t position = min<size_t>(m_size, max(_position, 0));
+	size_t line = lineOfPosition(position);
+	return tuple<int, int>(line, position - lineStarts()[line]);
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	call_once(m_lineIndex->built, [this]() {
+		vector<size_t>& starts = m_lineIndex->lineStarts;
+		starts.push_back(0);
+		for (char const* it = m_data; (it = find(it, m_data + m_size, '\n')) != m_data + m_size; ++it)
+			starts.push_back(it - m_data + 1);
+	});
+	return m_lineIndex->lineStarts;
 }
 
+size_t CharStream::lineOfPosition(size_t _position) const
+{
+	vector<size_t> const& starts = lineStarts();
+	// The last line that starts at or before the position.
+	return upper_bound(starts.begin(), starts.end(), _position) - starts.begin() - 1;
+}
 
 }
 }
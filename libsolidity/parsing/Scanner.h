@@ -52,6 +52,8 @@
 
 #pragma once
 
+#include <mutex>
+#include <vector>
 #include <libdevcore/Common.h>
 #include <libdevcore/CommonData.h>
 #include <libevmasm/SourceLocation.h>
@@ -70,29 +72,60 @@ class ParserRecorder;
 class CharStream
 {
 public:
-	CharStream(): m_position(0) {}
-	explicit CharStream(std::string const& _source): m_source(_source), m_position(0) {}
+	CharStream() {}
+	/// Creates a stream on a copy of @a _source.
+	explicit CharStream(std::string const& _source);
+	/// Creates a stream on the shared string @a _source without copying it.
+	explicit CharStream(std::shared_ptr<std::string const> const& _source);
+	/// Creates a stream on the @a _size characters at @a _data without copying them.
+	/// The memory is kept alive by @a _owner. If that is null, the memory has to outlive the
+	/// stream, all its copies and the scanners using it.
+	CharStream(char const* _data, size_t _size, std::shared_ptr<void const> const& _owner = nullptr);
+	/// @returns a stream on the memory-mapped contents of the file @a _path.
+	/// @throws FileError if the file cannot be read.
+	static CharStream fromFile(std::string const& _path);
+
 	int position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_size; }
+	char get(size_t _charsForward = 0) const
+	{
+		return m_position + _charsForward < m_size ? m_data[m_position + _charsForward] : 0;
+	}
 	char advanceAndGet(size_t _chars=1);
 	char rollback(size_t _amount);
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const { return m_source; }
+	/// @returns a view of the whole source. Copying the stream does not copy the source.
+	vector_ref<char const> source() const { return vector_ref<char const>(m_data, m_size); }
 
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// The first call builds an index of the line starts, after which lookups are logarithmic.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
-	std::string m_source;
-	size_t m_position;
+	/// Positions at which the lines of the source start, shared between copies of the stream.
+	struct LineIndex
+	{
+		std::once_flag built;
+		std::vector<size_t> lineStarts;
+	};
+
+	/// @returns the positions at which the lines start, building the index on first use.
+	std::vector<size_t> const& lineStarts() const;
+	/// @returns the index of the line containing @a _position (which is clamped to the source).
+	size_t lineOfPosition(size_t _position) const;
+
+	/// Keeps the memory of the source alive, if owned.
+	std::shared_ptr<void const> m_owner;
+	char const* m_data = nullptr;
+	size_t m_size = 0;
+	size_t m_position = 0;
+	std::shared_ptr<LineIndex> m_lineIndex = std::make_shared<LineIndex>();
 };
 
 
@@ -104,7 +137,8 @@ public:
 
 	explicit Scanner(CharStream const& _source = CharStream(), std::string const& _sourceName = "") { reset(_source, _sourceName); }
 
-	std::string source() const { return m_source.source(); }
+	/// @returns a view of the source, which is valid as long as the scanner is not reset.
+	vector_ref<char const> source() const { return m_source.source(); }
 
 	/// Resets the scanner as if newly constructed with _source and _sourceName as input.
 	void reset(CharStream const& _source, std::string const& _sourceName);
@@ -159,7 +193,6 @@ public:
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
 	std::string lineAtPosition(int _position) const { return m_source.lineAtPosition(_position); }
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const { return m_source.translatePositionToLineColumn(_position); }
 	///@}
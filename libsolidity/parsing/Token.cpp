@@ -40,9 +40,10 @@
 // You should have received a copy of the GNU General Public License
 // along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 
-#include <map>
+#include <algorithm>
+#include <cstring>
+#include <vector>
 #include <libsolidity/parsing/Token.h>
-#include <boost/range/iterator_range.hpp>
 
 using namespace std;
 
@@ -110,36 +111,152 @@ char const Token::m_tokenType[] =
 	TOKEN_LIST(KT, KK)
 };
 
-int Token::parseSize(string::const_iterator _begin, string::const_iterator _end)
+namespace
 {
-	try
+
+bool isDigit(char _c)
+{
+	return '0' <= _c && _c <= '9';
+}
+
+/**
+ * Perfect hash table of all keywords, built using "hash and displace" when it is first used:
+ * The keywords are distributed into buckets by a first hash function and each bucket is assigned
+ * a seed for a second hash function such that every keyword ends up in its own slot.
+ * A lookup thus computes two hashes and performs a single string comparison.
+ */
+class KeywordTable
+{
+public:
+	KeywordTable();
+
+	Token::Value lookup(char const* _begin, char const* _end) const
 	{
-		unsigned int m = boost::lexical_cast<int>(boost::make_iterator_range(_begin, _end));
-		return m;
+		uint32_t seed = m_seeds[hash(_begin, _end, 0) & (m_seeds.size() - 1)];
+		Slot const& slot = m_slots[hash(_begin, _end, seed) & (m_slots.size() - 1)];
+		if (slot.name && slot.length == size_t(_end - _begin) && equal(_begin, _end, slot.name))
+			return slot.token;
+		return Token::Identifier;
 	}
-	catch(boost::bad_lexical_cast const&)
+
+private:
+	struct Slot
+	{
+		char const* name = nullptr;
+		size_t length = 0;
+		Token::Value token = Token::Identifier;
+	};
+
+	static uint32_t hash(char const* _begin, char const* _end, uint32_t _seed)
+	{
+		uint32_t h = 2166136261u ^ (_seed * 0x9e3779b9u);
+		for (; _begin != _end; ++_begin)
+			h = (h ^ uint8_t(*_begin)) * 16777619u;
+		h ^= h >> 16;
+		h *= 0x85ebca6bu;
+		h ^= h >> 13;
+		return h;
+	}
+
+	std::vector<uint32_t> m_seeds;
+	std::vector<Slot> m_slots;
+};
+
+KeywordTable::KeywordTable()
+{
+	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+	// and keywords to be put inside the keywords variable.
+#define KEYWORD(name, string, precedence) {string, Token::name},
+#define TOKEN(name, string, precedence)
+	vector<pair<char const*, Token::Value>> const keywords{TOKEN_LIST(TOKEN, KEYWORD)};
+#undef KEYWORD
+#undef TOKEN
+
+	size_t slots = 2;
+	while (slots < 2 * keywords.size())
+		slots *= 2;
+	m_slots.resize(slots);
+	m_seeds.resize(slots / 2, 0);
+
+	vector<vector<size_t>> buckets(m_seeds.size());
+	for (size_t i = 0; i < keywords.size(); ++i)
 	{
+		char const* name = keywords[i].first;
+		buckets[hash(name, name + strlen(name), 0) & (buckets.size() - 1)].push_back(i);
+	}
+	vector<size_t> bucketOrder(buckets.size());
+	for (size_t i = 0; i < bucketOrder.size(); ++i)
+		bucketOrder[i] = i;
+	// Place the largest buckets first while there is still a lot of room.
+	stable_sort(bucketOrder.begin(), bucketOrder.end(), [&](size_t _a, size_t _b) {
+		return buckets[_a].size() > buckets[_b].size();
+	});
+
+	for (size_t bucket: bucketOrder)
+	{
+		if (buckets[bucket].empty())
+			break;
+		for (uint32_t seed = 1; ; ++seed)
+		{
+			vector<size_t> positions;
+			for (size_t keyword: buckets[bucket])
+			{
+				char const* name = keywords[keyword].first;
+				size_t position = hash(name, name + strlen(name), seed) & (slots - 1);
+				if (m_slots[position].name || count(positions.begin(), positions.end(), position))
+					break;
+				positions.push_back(position);
+			}
+			if (positions.size() < buckets[bucket].size())
+				continue;
+			for (size_t i = 0; i < positions.size(); ++i)
+			{
+				auto const& keyword = keywords[buckets[bucket][i]];
+				m_slots[positions[i]].name = keyword.first;
+				m_slots[positions[i]].length = strlen(keyword.first);
+				m_slots[positions[i]].token = keyword.second;
+			}
+			m_seeds[bucket] = seed;
+			break;
+		}
+	}
+}
+
+}
+
+int Token::parseSize(char const* _begin, char const* _end)
+{
+	if (_begin == _end)
 		return -1;
+	unsigned m = 0;
+	for (; _begin != _end; ++_begin)
+	{
+		if (!isDigit(*_begin))
+			return -1;
+		m = m * 10 + unsigned(*_begin - '0');
+		// All sizes are at most 256, so there is no need to represent larger values.
+		if (m > 0xffff)
+			return -1;
 	}
+	return m;
 }
 
-tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(string const& _literal)
+tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(char const* _begin, char const* _end)
 {
-	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
-	if (positionM != _literal.end())
+	char const* positionM = find_if(_begin, _end, isDigit);
+	if (positionM != _end)
 	{
-		string baseType(_literal.begin(), positionM);
-		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
+		char const* positionX = find_if_not(positionM, _end, isDigit);
 		int m = parseSize(positionM, positionX);
-		Token::Value keyword = keywordByName(baseType);
+		Token::Value keyword = keywordByName(_begin, positionM);
 		if (keyword == Token::Bytes)
 		{
-			if (0 < m && m <= 32 && positionX == _literal.end())
+			if (0 < m && m <= 32 && positionX == _end)
 				return make_tuple(Token::BytesM, m, 0);
 		}
 		else if (keyword == Token::UInt || keyword == Token::Int)
 		{
-			if (0 < m && m <= 256 && m % 8 == 0 && positionX == _literal.end())
+			if (0 < m && m <= 256 && m % 8 == 0 && positionX == _end)
 			{
 				if (keyword == Token::UInt)
 					return make_tuple(Token::UIntM, m, 0);
@@ -151,11 +268,11 @@ tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(s
 		{
 			if (
 				positionM < positionX &&
-				positionX < _literal.end() &&
+				positionX < _end &&
 				*positionX == 'x' &&
-				all_of(positionX + 1, _literal.end(), ::isdigit)
+				all_of(positionX + 1, _end, isDigit)
 			) {
-				int n = parseSize(positionX + 1, _literal.end());
+				int n = parseSize(positionX + 1, _end);
 				if (
 					0 <= m && m <= 256 &&
 					8 <= n && n <= 256 &&
@@ -169,24 +286,18 @@ tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(s
 					else
 						return make_tuple(Token::FixedMxN, m, n);
 				}
-			}	
+			}
 		}
 		return make_tuple(Token::Identifier, 0, 0);
 	}
 
-	return make_tuple(keywordByName(_literal), 0, 0);
+	return make_tuple(keywordByName(_begin, _end), 0, 0);
 }
-Token::Value Token::keywordByName(string const& _name)
+
+Token::Value Token::keywordByName(char const* _begin, char const* _end)
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
-#define KEYWORD(name, string, precedence) {string, Token::name},
-#define TOKEN(name, string, precedence)
-	static const map<string, Token::Value> keywords({TOKEN_LIST(TOKEN, KEYWORD)});
-#undef KEYWORD
-#undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+	static KeywordTable const keywords;
+	return keywords.lookup(_begin, _end);
 }
 
 #undef KT
@@ -312,13 +312,18 @@ public:
 		return m_precedence[tok];
 	}
 
-	static std::tuple<Token::Value, unsigned int, unsigned int> fromIdentifierOrKeyword(std::string const& _literal);
+	static std::tuple<Token::Value, unsigned int, unsigned int> fromIdentifierOrKeyword(std::string const& _literal)
+	{
+		return fromIdentifierOrKeyword(_literal.data(), _literal.data() + _literal.size());
+	}
+	/// Variant of the above for the characters in [_begin, _end), e.g. a range of the source buffer.
+	static std::tuple<Token::Value, unsigned int, unsigned int> fromIdentifierOrKeyword(char const* _begin, char const* _end);
 
 private:
 	// @returns -1 on error (invalid digit or number too large)
-	static int parseSize(std::string::const_iterator _begin, std::string::const_iterator _end);
-	// @returns the keyword with name @a _name or Token::Identifier of no such keyword exists.
-	static Token::Value keywordByName(std::string const& _name);
+	static int parseSize(char const* _begin, char const* _end);
+	// @returns the keyword with name [_begin, _end) or Token::Identifier of no such keyword exists.
+	static Token::Value keywordByName(char const* _begin, char const* _end);
 	static char const* const m_name[NUM_TOKENS];
 	static char const* const m_string[NUM_TOKENS];
 	static int8_t const m_precedence[NUM_TOKENS];
@@ -29,6 +29,7 @@
 #include <libsolidity/parsing/Parser.h>
 #include <libsolidity/ast/ASTPrinter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/ASTBinaryConverter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -38,6 +39,7 @@
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <libdevcore/Common.h>
 #include <libdevcore/CommonData.h>
@@ -71,9 +73,11 @@ static string const g_strAbi = "abi";
 static string const g_strAddStandard = "add-std";
 static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
+static string const g_strAsmBinary = "asm-binary";
 static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
+static string const g_strAstBinary = "ast-binary";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCloneBinary = "clone-bin";
@@ -92,12 +96,18 @@ static string const g_strNatspecUser = "userdoc";
 static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
+static string const g_strOptimizeConstantDepth = "optimize-constant-depth";
 static string const g_strOutputDir = "output-dir";
+static string const g_strPackStorage = "pack-storage";
+static string const g_strPCMap = "pc-map";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
+static string const g_strSrcMapBinary = "srcmap-binary";
+static string const g_strSrcMapRuntimeBinary = "srcmap-runtime-binary";
+static string const g_strStorageLayout = "storage-layout";
 static string const g_strVersion = "version";
 static string const g_stdinFileNameStr = "<stdin>";
 static string const g_strMetadataLiteral = "metadata-literal";
@@ -106,9 +116,11 @@ static string const g_argAbi = g_strAbi;
 static string const g_argAddStandard = g_strAddStandard;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
+static string const g_argAsmBinary = g_strAsmBinary;
 static string const g_argAssemble = g_strAssemble;
 static string const g_argAst = g_strAst;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argAstBinary = g_strAstBinary;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
 static string const g_argCloneBinary = g_strCloneBinary;
@@ -125,8 +137,12 @@ static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
+static string const g_argOptimizeConstantDepth = g_strOptimizeConstantDepth;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argPackStorage = g_strPackStorage;
+static string const g_argPCMap = g_strPCMap;
 static string const g_argSignatureHashes = g_strSignatureHashes;
+static string const g_argStorageLayout = g_strStorageLayout;
 static string const g_argVersion = g_strVersion;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
@@ -145,7 +161,10 @@ static set<string> const g_combinedJsonArgs{
 	g_strNatspecDev,
 	g_strOpcodes,
 	g_strSrcMap,
-	g_strSrcMapRuntime
+	g_strSrcMapRuntime,
+	g_strSrcMapBinary,
+	g_strSrcMapRuntimeBinary,
+	g_strStorageLayout
 };
 
 static void version()
@@ -169,7 +188,9 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 		g_argAbi,
 		g_argAsm,
 		g_argAsmJson,
+		g_argAsmBinary,
 		g_argAstJson,
+		g_argAstBinary,
 		g_argBinary,
 		g_argBinaryRuntime,
 		g_argCloneBinary,
@@ -178,7 +199,9 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 		g_argNatspecUser,
 		g_argNatspecDev,
 		g_argOpcodes,
-		g_argSignatureHashes
+		g_argPCMap,
+		g_argSignatureHashes,
+		g_argStorageLayout
 	})
 		if (_args.count(arg))
 			return true;
@@ -231,6 +254,41 @@ void CommandLineInterface::handleOpcode(string const& _contract)
 	}
 }
 
+void CommandLineInterface::handlePCMap(string const& _contract)
+{
+	if (!m_args.count(g_argPCMap))
+		return;
+
+	Json::Value pcMap(Json::objectValue);
+	pcMap["sourceList"] = Json::arrayValue;
+	for (auto const& source: m_compiler->sourceNames())
+		pcMap["sourceList"].append(source);
+	pcMap["pcMap"] = m_compiler->pcMapping(_contract);
+	pcMap["pcMapRuntime"] = m_compiler->runtimePCMapping(_contract);
+	if (m_args.count(g_argOutputDir))
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_pcmap.json", dev::jsonCompactPrint(pcMap));
+	else
+	{
+		cout << "Program counter to source mapping: " << endl;
+		cout << dev::jsonCompactPrint(pcMap) << endl;
+	}
+}
+
+void CommandLineInterface::handleStorageLayout(string const& _contract)
+{
+	if (!m_args.count(g_argStorageLayout))
+		return;
+
+	string data = dev::jsonCompactPrint(m_compiler->storageLayout(_contract));
+	if (m_args.count(g_argOutputDir))
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_storage.json", data);
+	else
+	{
+		cout << "Storage layout: " << endl;
+		cout << data << endl;
+	}
+}
+
 void CommandLineInterface::handleBytecode(string const& _contract)
 {
 	if (m_args.count(g_argOpcodes))
@@ -334,7 +392,7 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 		for (auto it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			GasEstimator::GasConsumption gas = GasEstimator::functionalEstimation(*items, sig);
+			GasEstimator::GasConsumption gas = GasEstimator::functionalEstimation(*items, it.first);
 			cout << "   " << sig << ":\t" << gas << endl;
 		}
 		if (contract.fallbackFunction())
@@ -455,14 +513,19 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 }
 
 void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+{
+	createFile(_fileName, [&](ostream& _out) { _out << _data; });
+}
+
+void CommandLineInterface::createFile(string const& _fileName, function<void(ostream&)> const& _writer, bool _binary)
 {
 	namespace fs = boost::filesystem;
 	// create directory if not existent
 	fs::path p(m_args.at(g_argOutputDir).as<string>());
 	fs::create_directories(p);
 	string pathName = (p / _fileName).string();
-	ofstream outFile(pathName);
-	outFile << _data;
+	ofstream outFile(pathName, _binary ? ios::out | ios::binary : ios::out);
+	_writer(outFile);
 	if (!outFile)
 		BOOST_THROW_EXCEPTION(FileError() << errinfo_comment("Could not write to file: " + pathName));
 }
@@ -493,6 +556,16 @@ Allowed options)",
 			po::value<unsigned>()->value_name("n")->default_value(200),
 			"Estimated number of contract runs for optimizer tuning."
 		)
+		(
+			g_argOptimizeConstantDepth.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(eth::ComputeMethodCache::defaultMaxDepth),
+			"Maximal recursion depth of the optimizer's search for cheap ways to compute constants."
+		)
+		(
+			g_argPackStorage.c_str(),
+			"Reorder the state variables of each contract to use fewer storage slots. "
+			"Changes the storage layout, see --storage-layout."
+		)
 		(g_argAddStandard.c_str(), "Add standard contracts.")
 		(
 			g_argLibraries.c_str(),
@@ -526,14 +599,18 @@ Allowed options)",
 	outputComponents.add_options()
 		(g_argAst.c_str(), "AST of all source files.")
 		(g_argAstJson.c_str(), "AST of all source files in JSON format.")
+		(g_argAstBinary.c_str(), "AST of all source files in a compact binary format (hex on stdout).")
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
+		(g_argAsmBinary.c_str(), "EVM assembly of the contracts in a compact binary format (hex on stdout).")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
+		(g_argPCMap.c_str(), "Sorted table mapping bytecode offsets of the contracts to source locations.")
 		(g_argBinary.c_str(), "Binary of the contracts in hex.")
 		(g_argBinaryRuntime.c_str(), "Binary of the runtime part of the contracts in hex.")
 		(g_argCloneBinary.c_str(), "Binary of the clone contracts in hex.")
 		(g_argAbi.c_str(), "ABI specification of the contracts.")
 		(g_argSignatureHashes.c_str(), "Function signature hashes of the contracts.")
+		(g_argStorageLayout.c_str(), "Positions of the state variables of the contracts in storage.")
 		(g_argNatspecUser.c_str(), "Natspec user documentation of all contracts.")
 		(g_argNatspecDev.c_str(), "Natspec developer documentation of all contracts.")
 		(g_argMetadata.c_str(), "Combined Metadata JSON whose Swarm hash is stored on-chain.")
@@ -646,10 +723,16 @@ bool CommandLineInterface::processInput()
 	{
 		if (m_args.count(g_argMetadataLiteral) > 0)
 			m_compiler->useMetadataLiteralSources(true);
+		m_compiler->setConstantOptimiserDepth(m_args[g_argOptimizeConstantDepth].as<unsigned>());
+		m_compiler->setPackStorage(m_args.count(g_argPackStorage) > 0);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_args[g_argInputFile].as<vector<string>>());
+		// The compiler only keeps views of the sources, existing entries of m_sourceCodes are not modified any more.
 		for (auto const& sourceCode: m_sourceCodes)
-			m_compiler->addSource(sourceCode.first, sourceCode.second);
+			m_compiler->addSource(
+				sourceCode.first,
+				CharStream(sourceCode.second.data(), sourceCode.second.size())
+			);
 		// TODO: Perhaps we should not compile unless requested
 		bool optimize = m_args.count(g_argOptimize) > 0;
 		unsigned runs = m_args[g_argOptimizeRuns].as<unsigned>();
@@ -740,10 +823,7 @@ void CommandLineInterface::handleCombinedJSON()
 		if (requests.count(g_strOpcodes))
 			contractData[g_strOpcodes] = solidity::disassemble(m_compiler->object(contractName).bytecode);
 		if (requests.count(g_strAsm))
-		{
-			ostringstream unused;
-			contractData[g_strAsm] = m_compiler->streamAssembly(unused, contractName, m_sourceCodes, true);
-		}
+			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName, m_sourceCodes);
 		if (requests.count(g_strSrcMap))
 		{
 			auto map = m_compiler->sourceMapping(contractName);
@@ -754,6 +834,18 @@ void CommandLineInterface::handleCombinedJSON()
 			auto map = m_compiler->runtimeSourceMapping(contractName);
 			contractData[g_strSrcMapRuntime] = map ? *map : "";
 		}
+		if (requests.count(g_strSrcMapBinary))
+		{
+			auto map = m_compiler->binarySourceMapping(contractName);
+			contractData[g_strSrcMapBinary] = map ? toHex(*map) : "";
+		}
+		if (requests.count(g_strSrcMapRuntimeBinary))
+		{
+			auto map = m_compiler->runtimeBinarySourceMapping(contractName);
+			contractData[g_strSrcMapRuntimeBinary] = map ? toHex(*map) : "";
+		}
+		if (requests.count(g_strStorageLayout))
+			contractData[g_strStorageLayout] = m_compiler->storageLayout(contractName);
 		if (requests.count(g_strNatspecDev))
 			contractData[g_strNatspecDev] = dev::jsonCompactPrint(m_compiler->metadata(contractName, DocumentationType::NatspecDev));
 		if (requests.count(g_strNatspecUser))
@@ -761,7 +853,12 @@ void CommandLineInterface::handleCombinedJSON()
 		output[g_strContracts][contractName] = contractData;
 	}
 
-	bool needsSourceList = requests.count(g_strAst) || requests.count(g_strSrcMap) || requests.count(g_strSrcMapRuntime);
+	bool needsSourceList =
+		requests.count(g_strAst) ||
+		requests.count(g_strSrcMap) ||
+		requests.count(g_strSrcMapRuntime) ||
+		requests.count(g_strSrcMapBinary) ||
+		requests.count(g_strSrcMapRuntimeBinary);
 	if (needsSourceList)
 	{
 		// Indices into this array are used to abbreviate source names in source locations.
@@ -792,6 +889,8 @@ void CommandLineInterface::handleAst(string const& _argStr)
 		title = "Syntax trees:";
 	else if (_argStr == g_argAstJson)
 		title = "JSON AST:";
+	else if (_argStr == g_argAstBinary)
+		title = "Binary AST:";
 	else
 		BOOST_THROW_EXCEPTION(InternalCompilerError() << errinfo_comment("Illegal argStr for AST"));
 
@@ -812,21 +911,22 @@ void CommandLineInterface::handleAst(string const& _argStr)
 		{
 			for (auto const& sourceCode: m_sourceCodes)
 			{
-				stringstream data;
-				string postfix = "";
+				boost::filesystem::path path(sourceCode.first);
 				if (_argStr == g_argAst)
 				{
+					stringstream data;
 					ASTPrinter printer(m_compiler->ast(sourceCode.first), sourceCode.second);
 					printer.print(data);
+					createFile(path.filename().string() + ".ast", data.str());
 				}
+				else if (_argStr == g_argAstBinary)
+					createFile(path.filename().string() + "_bin.ast", [&](ostream& _out) {
+						ASTBinaryConverter(_out, m_compiler->sourceIndices()).write(m_compiler->ast(sourceCode.first));
+					}, true);
 				else
-				{
-					ASTJsonConverter converter(m_compiler->ast(sourceCode.first));
-					converter.print(data);
-					postfix += "_json";
-				}
-				boost::filesystem::path path(sourceCode.first);
-				createFile(path.filename().string() + postfix + ".ast", data.str());
+					createFile(path.filename().string() + "_json.ast", [&](ostream& _out) {
+						ASTJsonConverter(m_compiler->ast(sourceCode.first)).stream(_out);
+					});
 			}
 		}
 		else
@@ -844,10 +944,16 @@ void CommandLineInterface::handleAst(string const& _argStr)
 					);
 					printer.print(cout);
 				}
+				else if (_argStr == g_argAstBinary)
+				{
+					stringstream data;
+					ASTBinaryConverter(data, m_compiler->sourceIndices()).write(m_compiler->ast(sourceCode.first));
+					cout << toHex(data.str()) << endl;
+				}
 				else
 				{
 					ASTJsonConverter converter(m_compiler->ast(sourceCode.first));
-					converter.print(cout);
+					converter.stream(cout);
 				}
 			}
 		}
@@ -965,6 +1071,7 @@ void CommandLineInterface::outputCompilationResults()
 	// do we need AST output?
 	handleAst(g_argAst);
 	handleAst(g_argAstJson);
+	handleAst(g_argAstBinary);
 
 	vector<string> contracts = m_compiler->contractNames();
 	for (string const& contract: contracts)
@@ -976,11 +1083,9 @@ void CommandLineInterface::outputCompilationResults()
 		if (m_args.count(g_argAsm) || m_args.count(g_argAsmJson))
 		{
 			if (m_args.count(g_argOutputDir))
-			{
-				stringstream data;
-				m_compiler->streamAssembly(data, contract, m_sourceCodes, m_args.count(g_argAsmJson));
-				createFile(contract + (m_args.count(g_argAsmJson) ? "_evm.json" : ".evm"), data.str());
-			}
+				createFile(contract + (m_args.count(g_argAsmJson) ? "_evm.json" : ".evm"), [&](ostream& _out) {
+					m_compiler->streamAssembly(_out, contract, m_sourceCodes, m_args.count(g_argAsmJson));
+				});
 			else
 			{
 				cout << "EVM assembly:" << endl;
@@ -988,10 +1093,27 @@ void CommandLineInterface::outputCompilationResults()
 			}
 		}
 
+		if (m_args.count(g_argAsmBinary))
+		{
+			if (m_args.count(g_argOutputDir))
+				createFile(contract + "_evm.bin", [&](ostream& _out) {
+					m_compiler->streamAssemblyBinary(_out, contract);
+				}, true);
+			else
+			{
+				stringstream data;
+				m_compiler->streamAssemblyBinary(data, contract);
+				cout << "EVM assembly (binary):" << endl;
+				cout << toHex(data.str()) << endl;
+			}
+		}
+
 		if (m_args.count(g_argGas))
 			handleGasEstimation(contract);
 
 		handleBytecode(contract);
+		handlePCMap(contract);
+		handleStorageLayout(contract);
 		handleSignatureHashes(contract);
 		handleOnChainMetadata(contract);
 		handleMeta(DocumentationType::ABIInterface, contract);
@@ -64,6 +64,8 @@ private:
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
 	void handleBytecode(std::string const& _contract);
+	void handlePCMap(std::string const& _contract);
+	void handleStorageLayout(std::string const& _contract);
 	void handleSignatureHashes(std::string const& _contract);
 	void handleOnChainMetadata(std::string const& _contract);
 	void handleMeta(DocumentationType _type, std::string const& _contract);
@@ -80,6 +82,8 @@ private:
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
+	/// Creates the file @a _fileName in the output directory and lets @a _writer write its contents.
+	void createFile(std::string const& _fileName, std::function<void(std::ostream&)> const& _writer, bool _binary = false);
 
 	bool m_onlyAssemble = false;
 	bool m_onlyLink = false;
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <functional>
+#include <set>
 #include <iostream>
 #include <json/json.h>
 #include <libdevcore/Common.h>
@@ -36,6 +37,7 @@
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
 #include <libsolidity/interface/SourceReferenceFormatter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/Version.h>
@@ -99,7 +101,7 @@ Json::Value estimateGas(CompilerStack const& _compiler, string const& _contract)
 		for (auto it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(GasEstimator::functionalEstimation(*items, sig));
+			externalFunctions[sig] = gasToJson(GasEstimator::functionalEstimation(*items, it.first));
 		}
 		if (contract.fallbackFunction())
 			externalFunctions[""] = gasToJson(GasEstimator::functionalEstimation(*items, "INVALID"));
@@ -126,7 +128,23 @@ Json::Value estimateGas(CompilerStack const& _compiler, string const& _contract)
 	return gasEstimates;
 }
 
-string compile(StringMap const& _sources, bool _optimize, CStyleReadFileCallback _readCallback)
+/// Parse results shared by all calls, sources that did not change are not parsed again.
+/// Only the most recently used sources are kept, see ParsedSourceCache::defaultMaxEntries.
+shared_ptr<ParsedSourceCache> const& parsedSourceCache()
+{
+	static shared_ptr<ParsedSourceCache> const cache = make_shared<ParsedSourceCache>();
+	return cache;
+}
+
+/// Compiles @a _sources. The outputs that are expensive to compute and rarely needed ("pcMap",
+/// which also adds "pcMapRuntime", and "storageLayout") are only generated if they are
+/// contained in @a _outputSelection.
+string compile(
+	StringMap const& _sources,
+	bool _optimize,
+	CStyleReadFileCallback _readCallback,
+	set<string> const& _outputSelection = set<string>()
+)
 {
 	Json::Value output(Json::objectValue);
 	Json::Value errors(Json::arrayValue);
@@ -161,6 +179,7 @@ string compile(StringMap const& _sources, bool _optimize, CStyleReadFileCallback
 		};
 	}
 	CompilerStack compiler(readCallback);
+	compiler.setParsedSourceCache(parsedSourceCache());
 	auto scannerFromSourceName = [&](string const& _sourceName) -> solidity::Scanner const& { return compiler.scanner(_sourceName); };
 	bool success = false;
 	try
@@ -225,8 +244,14 @@ string compile(StringMap const& _sources, bool _optimize, CStyleReadFileCallback
 				contractData["srcmap"] = sourceMap ? *sourceMap : "";
 				auto runtimeSourceMap = compiler.runtimeSourceMapping(contractName);
 				contractData["srcmapRuntime"] = runtimeSourceMap ? *runtimeSourceMap : "";
-				ostringstream unused;
-				contractData["assembly"] = compiler.streamAssembly(unused, contractName, _sources, true);
+				if (_outputSelection.count("pcMap"))
+				{
+					contractData["pcMap"] = compiler.pcMapping(contractName);
+					contractData["pcMapRuntime"] = compiler.runtimePCMapping(contractName);
+				}
+				contractData["assembly"] = compiler.assemblyJSON(contractName, _sources);
+				if (_outputSelection.count("storageLayout"))
+					contractData["storageLayout"] = compiler.storageLayout(contractName);
 				output["contracts"][contractName] = contractData;
 			}
 		}
@@ -303,7 +328,12 @@ string compileMulti(string const& _input, bool _optimize, CStyleReadFileCallback
 		if (jsonSources.isObject())
 			for (auto const& sourceName: jsonSources.getMemberNames())
 				sources[sourceName] = jsonSources[sourceName].asString();
-		return compile(sources, _optimize, _readCallback);
+		set<string> outputSelection;
+		Json::Value jsonOutputSelection = input["outputSelection"];
+		if (jsonOutputSelection.isArray())
+			for (auto const& output: jsonOutputSelection)
+				outputSelection.insert(output.asString());
+		return compile(sources, _optimize, _readCallback, outputSelection);
 	}
 }
 
@@ -0,0 +1,143 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Unit tests for the representation search of the constant optimiser.
+ */
+
+#include <libevmasm/ConstantOptimiser.h>
+#include <libevmasm/Assembly.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include "../TestHelper.h"
+
+using namespace std;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// Runtime, a single run and a single occurrence: computing constants pays off early.
+ConstantOptimisationMethod::Params const c_params{false, 1, 1};
+
+AssemblyItems computeRoutine(u256 const& _value, ComputeMethodCache& _cache)
+{
+	Assembly assembly;
+	return ComputeMethod(c_params, _value, _cache).execute(assembly);
+}
+
+bool containsInstruction(AssemblyItems const& _items, Instruction _instruction)
+{
+	return find(_items.begin(), _items.end(), AssemblyItem(_instruction)) != _items.end();
+}
+
+bool containsData(bytes const& _code, u256 const& _value)
+{
+	bytes data = toBigEndian(_value);
+	return search(_code.begin(), _code.end(), data.begin(), data.end()) != _code.end();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ConstantOptimiserTest)
+
+BOOST_AUTO_TEST_CASE(depth_limit_changes_representation)
+{
+	u256 const value = u256(1) << 255;
+	ComputeMethodCache unlimited;
+	ComputeMethodCache literalOnly(0);
+	AssemblyItems computed = computeRoutine(value, unlimited);
+	AssemblyItems literal = computeRoutine(value, literalOnly);
+
+	BOOST_CHECK(literal == AssemblyItems{value});
+	BOOST_CHECK(containsInstruction(computed, Instruction::EXP));
+	BOOST_CHECK(computed != literal);
+}
+
+BOOST_AUTO_TEST_CASE(depth_limit_applies_to_parts)
+{
+	// Computing the negated value needs one level, computing the power of two another one.
+	u256 const value = ~(u256(1) << 200);
+	ComputeMethodCache shallow(1);
+	ComputeMethodCache deep(2);
+	AssemblyItems shallowRoutine = computeRoutine(value, shallow);
+	AssemblyItems deepRoutine = computeRoutine(value, deep);
+
+	BOOST_CHECK((shallowRoutine == AssemblyItems{u256(1) << 200, Instruction::NOT}));
+	BOOST_CHECK((deepRoutine == AssemblyItems{u256(200), u256(2), Instruction::EXP, Instruction::NOT}));
+}
+
+BOOST_AUTO_TEST_CASE(cache_hit_matches_cache_miss)
+{
+	vector<u256> const values{
+		u256(1) << 255,
+		~(u256(1) << 200),
+		u256("0x77abc0000000000000000000000000000000000000000000000000000000001"),
+		u256("0x817416927846239487123469187231298734162934871263941234127518276"),
+		(u256(0x1234) << 128) - 7
+	};
+	ComputeMethodCache shared;
+	for (u256 const& value: values)
+	{
+		ComputeMethodCache fresh;
+		AssemblyItems miss = computeRoutine(value, shared);
+		AssemblyItems hit = computeRoutine(value, shared);
+		BOOST_CHECK(hit == miss);
+		BOOST_CHECK(computeRoutine(value, fresh) == miss);
+	}
+	// Parts of earlier values are cached with a smaller remaining depth,
+	// so the order in which values are computed must not matter either.
+	ComputeMethodCache reversed;
+	for (auto it = values.rbegin(); it != values.rend(); ++it)
+	{
+		ComputeMethodCache fresh;
+		BOOST_CHECK(computeRoutine(*it, reversed) == computeRoutine(*it, fresh));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimiser_depth_setting)
+{
+	char const* sourceCode = R"(
+		contract c {
+			uint a;
+			function f() { a = 0x77abc0000000000000000000000000000000000000000000000000000000001; }
+		}
+	)";
+	u256 const constant("0x77abc0000000000000000000000000000000000000000000000000000000001");
+
+	CompilerStack computing;
+	BOOST_REQUIRE(computing.compile(sourceCode, true, 1));
+	BOOST_CHECK(!containsData(computing.runtimeObject("c").bytecode, constant));
+
+	CompilerStack literal;
+	literal.setConstantOptimiserDepth(0);
+	BOOST_REQUIRE(literal.compile(sourceCode, true, 1));
+	BOOST_CHECK(containsData(literal.runtimeObject("c").bytecode, constant));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Unit tests for the memory arena of AST nodes.
+ */
+
+#include <string>
+#include <memory>
+#include <libsolidity/ast/ASTArena.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/parsing/Scanner.h>
+#include <libsolidity/parsing/Parser.h>
+#include "../TestHelper.h"
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// Counts how often objects of this type are destroyed.
+struct Counted
+{
+	explicit Counted(size_t& _destroyed): destroyed(_destroyed) {}
+	~Counted() { ++destroyed; }
+	size_t& destroyed;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolidityASTArena)
+
+BOOST_AUTO_TEST_CASE(allocation)
+{
+	ASTArena arena(256);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 0);
+	char* first = static_cast<char*>(arena.allocate(10, 1));
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 256);
+	char* aligned = static_cast<char*>(arena.allocate(8, 8));
+	BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(aligned) % 8, 0);
+	BOOST_CHECK(aligned == first + 16);
+
+	// Objects larger than a chunk get a chunk of their own, the current chunk is still used.
+	arena.allocate(1000, 8);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 256 + 1000);
+	BOOST_CHECK(arena.allocate(8, 8) == aligned + 8);
+
+	// The remaining 224 bytes of the first chunk are used up before a new chunk is started.
+	BOOST_CHECK(arena.allocate(224, 1) == aligned + 16);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 256 + 1000);
+	arena.allocate(1, 1);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 2 * 256 + 1000);
+}
+
+BOOST_AUTO_TEST_CASE(teardown)
+{
+	size_t destroyed = 0;
+	auto arena = make_shared<ASTArena>(64);
+	weak_ptr<ASTArena> arenaReference = arena;
+	vector<shared_ptr<Counted>> objects;
+	for (size_t i = 0; i < 100; ++i)
+		objects.push_back(makeArenaObject<Counted>(arena, destroyed));
+	BOOST_CHECK(arena->reservedBytes() >= 100 * sizeof(Counted));
+	size_t reserved = arena->reservedBytes();
+	arena.reset();
+
+	// The objects keep the arena alive.
+	shared_ptr<Counted> kept = objects[42];
+	objects.clear();
+	BOOST_CHECK_EQUAL(destroyed, 99);
+	BOOST_REQUIRE(!arenaReference.expired());
+	// Released objects do not return their memory to the arena.
+	BOOST_CHECK_EQUAL(arenaReference.lock()->reservedBytes(), reserved);
+	kept.reset();
+	BOOST_CHECK_EQUAL(destroyed, 100);
+	BOOST_CHECK(arenaReference.expired());
+
+	// Without an arena, objects are allocated on the heap.
+	makeArenaObject<Counted>(nullptr, destroyed);
+	BOOST_CHECK_EQUAL(destroyed, 101);
+}
+
+BOOST_AUTO_TEST_CASE(parse_into_arena)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint x;
+			/// @dev documentation
+			function f(uint a) returns (uint b) { b = a + x; }
+		}
+	)";
+	auto arena = make_shared<ASTArena>();
+	weak_ptr<ASTArena> arenaReference = arena;
+	ErrorList errors;
+	ASTPointer<SourceUnit> sourceUnit = Parser(errors, arena).parse(make_shared<Scanner>(CharStream(sourceCode)));
+	BOOST_REQUIRE(sourceUnit);
+	BOOST_CHECK(errors.empty());
+	BOOST_CHECK_EQUAL(arena->reservedBytes(), ASTArena::defaultChunkSize);
+	arena.reset();
+
+	// Parts of the AST stay valid after the source unit has been released.
+	ASTPointer<ASTNode> contract = sourceUnit->nodes().at(0);
+	sourceUnit.reset();
+	BOOST_REQUIRE(!arenaReference.expired());
+	auto contractDefinition = dynamic_cast<ContractDefinition const*>(contract.get());
+	BOOST_REQUIRE(contractDefinition);
+	BOOST_CHECK_EQUAL(contractDefinition->name(), "C");
+	BOOST_CHECK_EQUAL(contractDefinition->definedFunctions().at(0)->name(), "f");
+	contract.reset();
+	BOOST_CHECK(arenaReference.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
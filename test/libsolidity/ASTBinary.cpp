@@ -0,0 +1,215 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Tests for the binary ast output.
+ */
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <libdevcore/JSON.h>
+#include <libsolidity/interface/Exceptions.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/ASTBinaryConverter.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+string binaryAST(CompilerStack const& _compiler, string const& _source)
+{
+	ostringstream out;
+	ASTBinaryConverter(out, _compiler.sourceIndices()).write(_compiler.ast(_source));
+	return out.str();
+}
+
+/// Checks that the binary AST has the same structure as the JSON AST.
+void checkSameStructure(BinaryASTNode const& _node, Json::Value const& _json)
+{
+	BOOST_CHECK_EQUAL(_node.kind, _json["name"].asString());
+	if (_json.isMember("id"))
+		BOOST_CHECK_EQUAL(_node.id, _json["id"].asUInt64());
+	Json::Value const& children = _json["children"];
+	BOOST_REQUIRE_EQUAL(_node.children.size(), children.size());
+	for (size_t i = 0; i < _node.children.size(); ++i)
+		checkSameStructure(_node.children[i], children[Json::ArrayIndex(i)]);
+}
+
+/// Checks that the binary AST contains exactly the data of the JSON AST, apart from the
+/// documented differences of the binary format.
+void checkSameContent(BinaryASTNode const& _node, Json::Value const& _json)
+{
+	BOOST_REQUIRE_EQUAL(_node.kind, _json["name"].asString());
+	// The JSON converter omits the ID and location of the source unit.
+	if (_json.isMember("id"))
+		BOOST_CHECK_EQUAL(_node.id, _json["id"].asUInt64());
+	if (_json.isMember("src"))
+		BOOST_CHECK_EQUAL(
+			to_string(_node.start) + ":" + to_string(_node.length) + ":" + to_string(_node.sourceIndex),
+			_json["src"].asString()
+		);
+
+	set<string> binaryOnly{"typeIdentifier", "referencedDeclaration"};
+	if (_node.kind == "VariableDeclaration")
+		binaryOnly.insert({"constant", "visibility"});
+	Json::Value const& attributes = _json.isMember("attributes") ? _json["attributes"] : Json::Value(Json::objectValue);
+	for (string const& name: attributes.getMemberNames())
+		if (_node.kind == "Literal" && name == "hexvalue")
+			BOOST_CHECK_EQUAL(toHex(asBytes(_node.attributes["value"].asString())), attributes[name].asString());
+		else
+		{
+			BOOST_REQUIRE_MESSAGE(_node.attributes.isMember(name), _node.kind + "." + name);
+			BOOST_CHECK_EQUAL(jsonCompactPrint(_node.attributes[name]), jsonCompactPrint(attributes[name]));
+		}
+	for (string const& name: _node.attributes.getMemberNames())
+		BOOST_CHECK_MESSAGE(attributes.isMember(name) || binaryOnly.count(name), _node.kind + "." + name);
+
+	Json::Value const& children = _json.isMember("children") ? _json["children"] : Json::Value(Json::arrayValue);
+	BOOST_REQUIRE_EQUAL(_node.children.size(), children.size());
+	for (size_t i = 0; i < _node.children.size(); ++i)
+		checkSameContent(_node.children[i], children[Json::ArrayIndex(i)]);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolidityASTBinary)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	CompilerStack c;
+	c.addSource("a", R"(
+		contract C {
+			uint[] x;
+			enum E { A, B }
+			function f(uint a) returns (uint b) {
+				for (uint i = 0; i < a; i++)
+					x.push(i * 0x20);
+				b = a > 2 ? x[1] : uint(E.B);
+			}
+		}
+	)");
+	BOOST_REQUIRE(c.parse());
+	string data = binaryAST(c, "a");
+	BinaryASTNode root = ASTBinaryReader(bytesConstRef(&data)).read();
+	BOOST_CHECK_EQUAL(root.kind, "SourceUnit");
+	BOOST_CHECK_EQUAL(root.id, c.ast("a").id());
+	checkSameStructure(root, ASTJsonConverter(c.ast("a"), c.sourceIndices()).json());
+
+	BinaryASTNode const& contract = root.children.at(0);
+	BOOST_CHECK_EQUAL(contract.attributes["name"], "C");
+	BOOST_CHECK_EQUAL(contract.sourceIndex, c.sourceIndices().at("a"));
+	BOOST_CHECK_EQUAL(contract.attributes["linearizedBaseContracts"][0].asUInt64(), contract.id);
+	BinaryASTNode const& stateVariable = contract.children.at(0);
+	BOOST_CHECK_EQUAL(stateVariable.kind, "VariableDeclaration");
+	BOOST_CHECK_EQUAL(stateVariable.attributes["typeIdentifier"], "t_array$_t_uint256_$dyn_storage");
+}
+
+BOOST_AUTO_TEST_CASE(large_round_trip)
+{
+	// Enough distinct strings that the string table of the reader is reallocated many times.
+	string source = "contract C {\n\tuint[] x;\n\tevent Log(uint indexed value);\n";
+	for (size_t i = 0; i < 200; ++i)
+	{
+		string n = to_string(i);
+		source +=
+			"\t/// @dev function " + n + "\n"
+			"\tfunction f" + n + "(uint a" + n + ", bytes32 b" + n + ") returns (uint r" + n + ") {\n"
+			"\t\tuint local" + n + " = a" + n + " * " + n + ";\n"
+			"\t\tif (b" + n + " == \"s" + n + "\") Log(local" + n + ");\n"
+			"\t\tr" + n + " = local" + n + " + x.length;\n"
+			"\t}\n";
+	}
+	source += "}\n";
+	CompilerStack c;
+	c.addSource("a", source);
+	BOOST_REQUIRE(c.parse());
+	string data = binaryAST(c, "a");
+	BinaryASTNode root = ASTBinaryReader(bytesConstRef(&data)).read();
+	checkSameContent(root, ASTJsonConverter(c.ast("a"), c.sourceIndices()).json());
+}
+
+BOOST_AUTO_TEST_CASE(referenced_declarations)
+{
+	CompilerStack c;
+	c.addSource("a", "contract C { uint x; function f() returns (uint) { return x; } }");
+	BOOST_REQUIRE(c.parse());
+	string data = binaryAST(c, "a");
+	BinaryASTNode root = ASTBinaryReader(bytesConstRef(&data)).read();
+	BinaryASTNode const& contract = root.children.at(0);
+	BinaryASTNode const& x = contract.children.at(0);
+	BinaryASTNode const& returnStatement = contract.children.at(1).children.at(2).children.at(0);
+	BOOST_REQUIRE_EQUAL(returnStatement.kind, "Return");
+	BinaryASTNode const& identifier = returnStatement.children.at(0);
+	BOOST_CHECK_EQUAL(identifier.kind, "Identifier");
+	BOOST_CHECK_EQUAL(identifier.attributes["value"], "x");
+	BOOST_CHECK_EQUAL(identifier.attributes["referencedDeclaration"].asUInt64(), x.id);
+	BOOST_CHECK_EQUAL(identifier.attributes["typeIdentifier"], "t_uint256");
+}
+
+BOOST_AUTO_TEST_CASE(strings_are_interned)
+{
+	CompilerStack c;
+	string source = "contract C { function f() { uint someLongVariableName; ";
+	for (size_t i = 0; i < 20; ++i)
+		source += "someLongVariableName++; ";
+	source += "} }";
+	c.addSource("a", source);
+	BOOST_REQUIRE(c.parse());
+	string data = binaryAST(c, "a");
+	BOOST_CHECK_EQUAL(data.find("someLongVariableName"), data.rfind("someLongVariableName"));
+}
+
+BOOST_AUTO_TEST_CASE(invalid_data)
+{
+	CompilerStack c;
+	c.addSource("a", "contract C { function f() {} }");
+	BOOST_REQUIRE(c.parse());
+	string data = binaryAST(c, "a");
+	BOOST_CHECK_THROW(ASTBinaryReader(bytesConstRef(&data).cropped(0, data.size() - 1)).read(), InvalidBinaryAST);
+	data[0] = 'X';
+	BOOST_CHECK_THROW(ASTBinaryReader(bytesConstRef(&data)).read(), InvalidBinaryAST);
+
+	// Nodes nested deeper than the limit: each node consists of the marker, its kind "N",
+	// the id, the source location, no attributes and its first child.
+	string nested = string("SAST") + char(1) + string{char(1), char(0), char(1), 'N', char(0), char(0), char(0), char(0), char(0)};
+	for (size_t i = 0; i < 100000; ++i)
+		nested += string{char(1), char(0), char(0), char(0), char(0), char(0), char(0)};
+	BOOST_CHECK_THROW(ASTBinaryReader(bytesConstRef(&nested)).read(), InvalidBinaryAST);
+	BOOST_CHECK_THROW(ASTBinaryReader(bytesConstRef(&data), 2).read(), InvalidBinaryAST);
+	// Deeply nested arrays as attribute values.
+	string array = string("SAST") + char(1) + string{char(1), char(0), char(1), 'N', char(0), char(0), char(0), char(0), char(1), char(1), char(1), 'a'};
+	for (size_t i = 0; i < 100000; ++i)
+		array += string{char(5), char(1)};
+	BOOST_CHECK_THROW(ASTBinaryReader(bytesConstRef(&array)).read(), InvalidBinaryAST);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
@@ -21,6 +21,7 @@
  */
 
 #include <string>
+#include <sstream>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -228,6 +229,39 @@ BOOST_AUTO_TEST_CASE(function_type)
 	BOOST_CHECK_EQUAL(funType["attributes"]["visibility"], "external");
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	CompilerStack c;
+	c.addSource("a", R"(
+		import "b";
+		contract C is B {
+			struct S { uint a; mapping(uint => bytes32) m; }
+			event E(uint indexed x);
+			modifier m { _; }
+			function f(uint a) m returns (uint[] r) {
+				var (x, y) = (a, "\xff");
+				while (x < 10) { x += uint8(2); if (x == 3) break; }
+				r = new uint[](2 ether);
+				E(x);
+				assembly { pop(1) }
+				do { x--; } while (false);
+			}
+		}
+	)");
+	c.addSource("b", "contract B { function() payable {} } contract D {}");
+	BOOST_REQUIRE(c.parse());
+	map<string, unsigned> sourceIndices;
+	sourceIndices["a"] = 1;
+	for (char const* source: {"a", "b"})
+	{
+		ostringstream streamed;
+		ASTJsonConverter(c.ast(source), sourceIndices).stream(streamed);
+		ostringstream printed;
+		ASTJsonConverter(c.ast(source), sourceIndices).print(printed);
+		BOOST_CHECK_EQUAL(streamed.str(), printed.str());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
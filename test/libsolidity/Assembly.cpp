@@ -31,6 +31,8 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/analysis/TypeChecker.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/CompilerStack.h>
 
 using namespace std;
 using namespace dev::eth;
@@ -47,6 +49,8 @@ namespace
 
 eth::AssemblyItems compileContract(const string& _sourceCode)
 {
+	TypeProvider typeProvider;
+	TypeProvider::Scope typeProviderScope(typeProvider);
 	ErrorList errors;
 	Parser parser(errors);
 	ASTPointer<SourceUnit> sourceUnit;
@@ -124,6 +128,227 @@ BOOST_AUTO_TEST_CASE(location_test)
 	checkAssemblyLocations(items, locations);
 }
 
+BOOST_AUTO_TEST_CASE(streamed_json)
+{
+	char const* sourceCode = R"(
+	contract test {
+		bytes32 constant c = "\"quoted\"";
+		function f(uint a) returns (uint256 b) {
+			b = a * 0x817416927846239487123469187231298734162934871263941234127518276;
+		}
+		function g() returns (bytes32) {
+			return c;
+		}
+	}
+	)";
+	CompilerStack compiler;
+	BOOST_REQUIRE(compiler.compile(string(sourceCode), true));
+	ostringstream streamed;
+	compiler.streamAssembly(streamed, "test", StringMap(), true);
+	ostringstream expectation;
+	expectation << compiler.assemblyJSON("test") << endl;
+	BOOST_CHECK_EQUAL(streamed.str(), expectation.str());
+
+}
+
+BOOST_AUTO_TEST_CASE(binary_round_trip)
+{
+	char const* sourceCode = R"(
+	library L { function f(uint a) returns (uint) { return a + 1; } }
+	contract test {
+		bytes32 constant c = "\"quoted\"";
+		uint x;
+		function f(uint a) returns (uint256 b) {
+			b = L.f(a) * 0x817416927846239487123469187231298734162934871263941234127518276;
+			x = g(b);
+		}
+		function g(uint a) internal returns (uint) {
+			for (uint i = 0; i < a; i++)
+				a += i;
+			return a;
+		}
+		function h() returns (bytes32, string) {
+			new C();
+			return (c, "a string that is longer than thirty-two bytes and thus not a literal");
+		}
+	}
+	contract C { function() payable { } }
+	)";
+	CompilerStack compiler;
+	BOOST_REQUIRE(compiler.compile(string(sourceCode), true));
+	ostringstream binary;
+	compiler.streamAssemblyBinary(binary, "test");
+	string encoded = binary.str();
+	BOOST_CHECK_EQUAL(encoded.substr(0, 5), string("EVMA") + char(1));
+
+	AssemblyPointer assembly = eth::Assembly::fromBinary(bytesConstRef(&encoded));
+	AssemblyItems const& original = *compiler.assemblyItems("test");
+	BOOST_REQUIRE_EQUAL(assembly->items().size(), original.size());
+	for (size_t i = 0; i < original.size(); ++i)
+	{
+		AssemblyItem const& item = assembly->items()[i];
+		BOOST_CHECK(item == original[i]);
+		BOOST_CHECK(item.getJumpType() == original[i].getJumpType());
+		BOOST_CHECK_EQUAL(item.location().start, original[i].location().start);
+		BOOST_CHECK_EQUAL(item.location().end, original[i].location().end);
+	}
+	BOOST_CHECK(assembly->assemblyJSON() == compiler.assemblyJSON("test"));
+	BOOST_CHECK(assembly->assemble().bytecode == compiler.object("test").bytecode);
+	BOOST_CHECK(assembly->assemble().linkReferences == compiler.object("test").linkReferences);
+	ostringstream reencoded;
+	assembly->streamBinary(reencoded);
+	BOOST_CHECK(reencoded.str() == encoded);
+
+	// Truncated and trailing data is rejected.
+	for (size_t length: {size_t(0), size_t(4), size_t(5), encoded.size() / 2, encoded.size() - 1})
+	{
+		string truncated = encoded.substr(0, length);
+		BOOST_CHECK_THROW(eth::Assembly::fromBinary(bytesConstRef(&truncated)), InvalidBinaryAssembly);
+	}
+	string extended = encoded + char(0);
+	BOOST_CHECK_THROW(eth::Assembly::fromBinary(bytesConstRef(&extended)), InvalidBinaryAssembly);
+	// So is unbounded nesting of sub-assemblies.
+	string nested = string("EVMA") + char(1);
+	for (size_t i = 0; i < 1000; ++i)
+		nested += string{char(1), char(0), char(0), char(0), char(1)};
+	BOOST_CHECK_THROW(eth::Assembly::fromBinary(bytesConstRef(&nested)), InvalidBinaryAssembly);
+}
+
+BOOST_AUTO_TEST_CASE(binary_source_mapping)
+{
+	char const* sourceCode = R"(
+	contract test {
+		uint x;
+		function f(uint a) returns (uint b) {
+			for (uint i = 0; i < a; i++)
+				b += g(i);
+			x = b;
+		}
+		function g(uint a) internal returns (uint) {
+			return a * a + x;
+		}
+	}
+	)";
+	CompilerStack compiler;
+	BOOST_REQUIRE(compiler.compile(string(sourceCode), true));
+	for (bool runtime: {false, true})
+	{
+		bytes const* encoded = runtime ? compiler.runtimeBinarySourceMapping("test") : compiler.binarySourceMapping("test");
+		string const* text = runtime ? compiler.runtimeSourceMapping("test") : compiler.sourceMapping("test");
+		BOOST_REQUIRE(encoded && text);
+		BinarySourceMap map(ref(*encoded));
+		size_t items = (runtime ? compiler.runtimeAssemblyItems("test") : compiler.assemblyItems("test"))->size();
+		BOOST_REQUIRE_EQUAL(map.size(), items);
+		vector<SourceMapEntry> entries;
+		for (size_t i = 0; i < map.size(); ++i)
+			entries.push_back(map.at(i));
+		BOOST_CHECK_EQUAL(compressSourceMapping(entries), *text);
+		// Random access has to agree with sequential decoding.
+		BOOST_CHECK(map.at(map.size() - 1) == entries.back());
+		if (runtime)
+		{
+			BOOST_REQUIRE(map.size() > BinarySourceMap::defaultBlockSize);
+			BOOST_CHECK(map.at(BinarySourceMap::defaultBlockSize) == entries[BinarySourceMap::defaultBlockSize]);
+		}
+		// Lookup by program counter, including positions inside push data.
+		vector<size_t> const& offsets = (runtime ? compiler.runtimeObject("test") : compiler.object("test")).itemOffsets;
+		BOOST_REQUIRE_EQUAL(offsets.size(), map.size());
+		for (size_t i = 0; i < offsets.size(); ++i)
+		{
+			size_t end = i + 1 < offsets.size() ? offsets[i + 1] : offsets[i] + 1;
+			for (size_t pc = offsets[i]; pc < end; ++pc)
+			{
+				BOOST_CHECK_EQUAL(map.instructionAt(pc), i);
+				BOOST_CHECK(map.atProgramCounter(pc) == entries[i]);
+			}
+		}
+		if (offsets.front() > 0)
+			BOOST_CHECK_THROW(map.instructionAt(0), InvalidSourceMap);
+	}
+	// Small blocks, a program counter before the first instruction and beyond the last one.
+	vector<SourceMapEntry> entries(5);
+	for (int i = 0; i < 5; ++i)
+		entries[i].start = 10 * i;
+	bytes encoded = BinarySourceMap::encode(entries, {3, 4, 6, 40, 41}, 2);
+	BinarySourceMap map(ref(encoded));
+	BOOST_CHECK_THROW(map.instructionAt(2), InvalidSourceMap);
+	vector<size_t> expectation{0, 1, 1, 2, 2, 2, 3, 4, 4};
+	vector<size_t> programCounters{3, 4, 5, 6, 7, 39, 40, 41, 1000};
+	for (size_t i = 0; i < programCounters.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(map.instructionAt(programCounters[i]), expectation[i]);
+		BOOST_CHECK_EQUAL(map.atProgramCounter(programCounters[i]).start, 10 * int(expectation[i]));
+	}
+	BOOST_CHECK_THROW(BinarySourceMap::encode(entries, {3, 4, 2, 40, 41}), InvalidSourceMap);
+	bytes invalid{'S', 'M', 'A', 'X', 1};
+	BOOST_CHECK_THROW(BinarySourceMap(ref(invalid)), InvalidSourceMap);
+}
+
+BOOST_AUTO_TEST_CASE(pc_mapping)
+{
+	char const* sourceCode = R"(
+	library L { function f(uint a) returns (uint) { return a + 1; } }
+	contract test {
+		function f(uint a) returns (uint b) {
+			b = L.f(a) * 0x1234567890abcdef;
+		}
+	}
+	)";
+	CompilerStack compiler;
+	BOOST_REQUIRE(compiler.compile(string(sourceCode), false));
+	for (bool runtime: {false, true})
+	{
+		AssemblyItems const& items = *(runtime ? compiler.runtimeAssemblyItems("test") : compiler.assemblyItems("test"));
+		bytes const& code = (runtime ? compiler.runtimeObject("test") : compiler.object("test")).bytecode;
+		Json::Value map = runtime ? compiler.runtimePCMapping("test") : compiler.pcMapping("test");
+		BOOST_REQUIRE_EQUAL(map.size(), items.size());
+		for (unsigned i = 0; i < items.size(); ++i)
+		{
+			size_t pc = map[i][0].asUInt64();
+			BOOST_REQUIRE(pc < code.size());
+			if (i > 0)
+				BOOST_CHECK(pc > map[i - 1][0].asUInt64());
+			if (items[i].type() == Operation)
+				BOOST_CHECK(code[pc] == byte(items[i].instruction()));
+			else if (items[i].type() == Tag)
+				BOOST_CHECK(code[pc] == byte(Instruction::JUMPDEST));
+			BOOST_CHECK_EQUAL(map[i][1].asInt(), items[i].location().start);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(constructor_only_functions_not_in_runtime)
+{
+	string sourceCode = R"(
+	contract test {
+		uint x;
+		function init(uint a) internal returns (uint) { return helper(a) * 2; }
+		function helper(uint a) internal returns (uint) { return a + 7; }
+		function test() { x = init(3); }
+		function f() returns (uint) { return x + helper(1); }
+	}
+	)";
+	CompilerStack compiler;
+	BOOST_REQUIRE(compiler.compile(sourceCode, false));
+	auto inFunction = [&](AssemblyItem const& _item, string const& _function)
+	{
+		size_t start = sourceCode.find("function " + _function);
+		size_t end = sourceCode.find("}", start);
+		return _item.location().start >= int(start) && _item.location().end <= int(end) + 1;
+	};
+	bool initInCreation = false;
+	for (AssemblyItem const& item: *compiler.assemblyItems("test"))
+		initInCreation = initInCreation || inFunction(item, "init");
+	BOOST_CHECK(initInCreation);
+	bool helperInRuntime = false;
+	for (AssemblyItem const& item: *compiler.runtimeAssemblyItems("test"))
+	{
+		BOOST_CHECK(!inFunction(item, "init"));
+		helperInRuntime = helperInRuntime || inFunction(item, "helper");
+	}
+	BOOST_CHECK(helperInRuntime);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -21,9 +21,14 @@
  */
 
 #include <string>
+#include <set>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
+#include <libdevcore/SHA3.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
 
 using namespace std;
 
@@ -202,6 +207,164 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent)
 	BOOST_CHECK(d.compile());
 }
 
+BOOST_AUTO_TEST_CASE(concurrently_parsed_sources)
+{
+	CompilerStack c([](string const& _path) {
+		return CompilerStack::ReadFileResult{true, "import {L} from \"lib\"; contract " + _path + " { uint x = L.f(); } pragma solidity >=0.0;"};
+	});
+	c.addSource("lib", "library L { function f() returns (uint) { return 7; } } pragma solidity >=0.0;");
+	vector<string> names;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		names.push_back("S" + to_string(i));
+		c.addSource(names.back(), "import \"I" + to_string(i) + "\"; contract " + names.back() + " is I" + to_string(i) + " {} pragma solidity >=0.0;");
+	}
+	BOOST_REQUIRE(c.compile());
+	// Node IDs are unique and increase with the order in which the sources are parsed:
+	// first the sources given, then the imported ones.
+	for (size_t i = 0; i < 8; ++i)
+		names.push_back("I" + to_string(i));
+	set<size_t> ids;
+	size_t previousMax = 0;
+	for (string const& name: names)
+	{
+		size_t minID = size_t(-1);
+		size_t maxID = 0;
+		SimpleASTVisitor visitor([&](ASTNode const& _node) {
+			BOOST_CHECK(ids.insert(_node.id()).second);
+			minID = min(minID, _node.id());
+			maxID = max(maxID, _node.id());
+			return true;
+		}, [](ASTNode const&) {});
+		c.ast(name).accept(visitor);
+		BOOST_CHECK_GT(minID, previousMax);
+		previousMax = maxID;
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrently_parsed_sources_error_order)
+{
+	CompilerStack c;
+	for (size_t i = 0; i < 6; ++i)
+		c.addSource("s" + to_string(i), "contract C" + to_string(i) + " { function f() { " + string(i, ' ') + "return } }");
+	BOOST_CHECK(!c.parse());
+	ErrorList errors;
+	for (auto const& error: c.errors())
+		if (error->type() != Error::Type::Warning)
+			errors.push_back(error);
+	BOOST_REQUIRE_EQUAL(errors.size(), 6);
+	for (size_t i = 0; i < 6; ++i)
+	{
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*errors[i]);
+		BOOST_REQUIRE(location);
+		BOOST_CHECK_EQUAL(*location->sourceName, "s" + to_string(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(import_errors_sorted_by_name)
+{
+	CompilerStack c;
+	c.addSource("a", "contract Z {} contract Y {} pragma solidity >=0.0;");
+	c.addSource("b", "import \"a\"; contract Y {} contract Z {} pragma solidity >=0.0;");
+	BOOST_CHECK(!c.compile());
+	vector<string> messages;
+	for (auto const& error: c.errors())
+		if (error->type() == Error::Type::DeclarationError)
+			messages.push_back(*boost::get_error_info<errinfo_comment>(*error));
+	BOOST_CHECK((messages == vector<string>{
+		"Identifier \"Y\" already declared.",
+		"Identifier \"Z\" already declared."
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(inheritance_errors_sorted_by_name)
+{
+	string const source = R"(
+		pragma solidity >=0.0;
+		contract A { uint z; uint y; }
+		contract B is A { function y() {} function z() {} }
+	)";
+	CompilerStack c;
+	c.addSource("a", source);
+	BOOST_CHECK(!c.compile());
+	vector<string> locations;
+	for (auto const& error: c.errors())
+		if (error->type() == Error::Type::DeclarationError)
+		{
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+			BOOST_REQUIRE(location);
+			locations.push_back(source.substr(location->start, location->end - location->start));
+		}
+	BOOST_CHECK((locations == vector<string>{"function y() {}", "function z() {}"}));
+}
+
+BOOST_AUTO_TEST_CASE(parsed_source_cache)
+{
+	auto cache = make_shared<ParsedSourceCache>();
+	string const lib = "library L { function f() returns (uint) { return 7; } } pragma solidity >=0.0;";
+	string const main = "import \"lib\"; contract C { function g() returns (uint) { return L.f(); } } pragma solidity >=0.0;";
+	Json::Value interface;
+	size_t libID = 0;
+	{
+		CompilerStack c;
+		c.setParsedSourceCache(cache);
+		c.addSource("lib", lib, true);
+		c.addSource("main", main);
+		BOOST_REQUIRE(c.compile());
+		interface = c.interface("C");
+		libID = c.ast("lib").id();
+		BOOST_CHECK_EQUAL(cache->size(), 0);
+	}
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+
+	CompilerStack c;
+	c.setParsedSourceCache(cache);
+	c.addSource("lib", lib, true);
+	c.addSource("main", main + "\n");
+	BOOST_REQUIRE(c.compile());
+	// The library is taken from the cache, the modified source is parsed again.
+	BOOST_CHECK_EQUAL(cache->size(), 1);
+	BOOST_CHECK_EQUAL(c.ast("lib").id(), libID);
+	BOOST_CHECK(c.interface("C") == interface);
+	c.reset();
+	BOOST_CHECK_EQUAL(cache->size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(parsed_source_cache_eviction)
+{
+	auto parsed = []()
+	{
+		ParsedSource source;
+		source.ast = make_shared<SourceUnit>(SourceLocation(), vector<ASTPointer<ASTNode>>());
+		return source;
+	};
+	h256 const hash = keccak256("contents");
+	ParsedSourceCache cache(2);
+	cache.store("a", hash, parsed());
+	cache.store("b", hash, parsed());
+	// Using "a" makes "b" the least recently used entry.
+	ParsedSource a = cache.take("a", hash);
+	BOOST_REQUIRE(a.ast);
+	cache.store("a", hash, move(a));
+	cache.store("c", hash, parsed());
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK(!cache.take("b", hash).ast);
+	BOOST_CHECK(cache.take("a", hash).ast);
+	BOOST_CHECK(cache.take("c", hash).ast);
+	BOOST_CHECK_EQUAL(cache.size(), 0);
+
+	// Storing an entry again does not evict another one.
+	cache.store("a", hash, parsed());
+	cache.store("b", hash, parsed());
+	cache.store("b", hash, parsed());
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK(cache.take("a", hash).ast);
+
+	ParsedSourceCache disabled(0);
+	disabled.store("a", hash, parsed());
+	BOOST_CHECK_EQUAL(disabled.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
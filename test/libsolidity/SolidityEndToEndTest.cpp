@@ -4773,6 +4773,33 @@ BOOST_AUTO_TEST_CASE(packed_storage_signed)
 	BOOST_CHECK( callContractFunction("test()") == encodeArgs(u256(-2), u256(4), u256(-112), u256(0)));
 }
 
+BOOST_AUTO_TEST_CASE(packed_storage_reordered)
+{
+	char const* sourceCode = R"(
+		contract A {
+			uint128 a;
+		}
+		contract C is A {
+			uint b;
+			uint64 c;
+			uint64 d;
+			function set() {
+				a = 0x11; b = 0x22; c = 0x33; d = 0x44;
+			}
+			function get() returns (uint128, uint, uint64, uint64) { return (a, b, c, d); }
+			function slot(uint i) returns (uint r) { assembly { r := sload(i) } }
+		}
+	)";
+	m_compiler.setPackStorage(true);
+	compileAndRun(sourceCode, 0, "C");
+	BOOST_CHECK(callContractFunction("set()") == encodeArgs());
+	BOOST_CHECK(callContractFunction("get()") == encodeArgs(0x11, 0x22, 0x33, 0x44));
+	// c and d fill the slot of a, b gets a slot of its own.
+	BOOST_CHECK(callContractFunction("slot(uint256)", 0) == encodeArgs((u256(0x44) << 192) | (u256(0x33) << 128) | u256(0x11)));
+	BOOST_CHECK(callContractFunction("slot(uint256)", 1) == encodeArgs(0x22));
+	BOOST_CHECK(callContractFunction("slot(uint256)", 2) == encodeArgs(0));
+}
+
 BOOST_AUTO_TEST_CASE(external_types_in_calls)
 {
 	char const* sourceCode = R"(
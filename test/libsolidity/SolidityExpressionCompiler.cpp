@@ -30,6 +30,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/analysis/TypeChecker.h>
 #include "../TestHelper.h"
+#include "TypeProviderFixture.h"
 
 using namespace std;
 
@@ -164,7 +165,7 @@ bytes compileFirstExpression(
 
 } // end anonymous namespace
 
-BOOST_AUTO_TEST_SUITE(SolidityExpressionCompiler)
+BOOST_FIXTURE_TEST_SUITE(SolidityExpressionCompiler, TypeProviderFixture)
 
 BOOST_AUTO_TEST_CASE(literal_true)
 {
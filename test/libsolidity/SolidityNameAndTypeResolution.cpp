@@ -31,8 +31,11 @@
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/analysis/GlobalContext.h>
 #include <libsolidity/analysis/TypeChecker.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
 #include "../TestHelper.h"
 #include "ErrorCheck.h"
+#include "TypeProviderFixture.h"
 
 using namespace std;
 
@@ -81,16 +84,28 @@ parseAnalyseAndReturnError(string const& _source, bool _reportWarnings = false,
 					success = false;
 			}
 		if (success)
+		{
+			// Mirrors the order of the type checking steps in CompilerStack.
+			vector<ContractDefinition const*> contracts;
 			for (ASTPointer<ASTNode> const& node: sourceUnit->nodes())
 				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-				{
-					globalContext->setCurrentContract(*contract);
-					resolver.updateDeclaration(*globalContext->currentThis());
-
-					TypeChecker typeChecker(errors);
-					bool success = typeChecker.checkTypeRequirements(*contract);
-					BOOST_CHECK(success || !errors.empty());
-				}
+					contracts.push_back(contract);
+			vector<ErrorList> contractErrors(contracts.size());
+			vector<unique_ptr<TypeChecker>> typeCheckers;
+			for (size_t i = 0; i < contracts.size(); ++i)
+			{
+				typeCheckers.emplace_back(new TypeChecker(contractErrors[i]));
+				typeCheckers[i]->checkContractDefinition(*contracts[i]);
+			}
+			for (size_t i = 0; i < contracts.size(); ++i)
+				typeCheckers[i]->checkContractMembers(*contracts[i]);
+			for (size_t i = 0; i < contracts.size(); ++i)
+			{
+				bool success = typeCheckers[i]->registerContractCreations();
+				BOOST_CHECK(success || !contractErrors[i].empty());
+				errors += contractErrors[i];
+			}
+		}
 		if (success)
 		{
 			StaticAnalyzer staticAnalyzer(errors);
@@ -125,6 +140,41 @@ parseAnalyseAndReturnError(string const& _source, bool _reportWarnings = false,
 	return make_pair(sourceUnit, nullptr);
 }
 
+/// Compiles @a _sources using at most @a _maxThreads threads.
+/// @returns the errors, the annotated ASTs and, if compilation succeeds, the interface,
+/// documentation and bytecode of all contracts.
+Json::Value compileWithThreads(map<string, string> const& _sources, unsigned _maxThreads)
+{
+	CompilerStack c;
+	c.setMaxThreads(_maxThreads);
+	for (auto const& source: _sources)
+		c.addSource(source.first, source.second);
+	bool success = c.compile();
+	Json::Value result(Json::objectValue);
+	result["errors"] = Json::arrayValue;
+	for (auto const& error: c.errors())
+	{
+		string text = error->typeName();
+		if (string const* description = boost::get_error_info<errinfo_comment>(*error))
+			text += ": " + *description;
+		if (SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error))
+			if (location->sourceName)
+				text += " @" + *location->sourceName + ":" + to_string(location->start) + "-" + to_string(location->end);
+		result["errors"].append(text);
+	}
+	for (string const& source: c.sourceNames())
+		result["ast"][source] = ASTJsonConverter(c.ast(source)).json();
+	if (success)
+		for (string const& contract: c.contractNames())
+		{
+			result["contracts"][contract]["abi"] = c.interface(contract);
+			result["contracts"][contract]["devdoc"] = c.metadata(contract, DocumentationType::NatspecDev);
+			result["contracts"][contract]["userdoc"] = c.metadata(contract, DocumentationType::NatspecUser);
+			result["contracts"][contract]["bytecode"] = toHex(c.object(contract).bytecode);
+		}
+	return result;
+}
+
 ASTPointer<SourceUnit> parseAndAnalyse(string const& _source)
 {
 	auto sourceAndError = parseAnalyseAndReturnError(_source);
@@ -203,7 +253,7 @@ do \
 while(0)
 
 
-BOOST_AUTO_TEST_SUITE(SolidityNameAndTypeResolution)
+BOOST_FIXTURE_TEST_SUITE(SolidityNameAndTypeResolution, TypeProviderFixture)
 
 BOOST_AUTO_TEST_CASE(smoke_test)
 {
@@ -607,6 +657,17 @@ BOOST_AUTO_TEST_CASE(create_abstract_contract)
 	CHECK_ERROR(text, TypeError, "");
 }
 
+BOOST_AUTO_TEST_CASE(create_abstract_contract_declared_later)
+{
+	char const* text = R"(
+		contract derived {
+			function foo() { new base(); }
+		}
+		contract base { function foo(); }
+	)";
+	CHECK_ERROR(text, TypeError, "Trying to create an instance of an abstract contract.");
+}
+
 BOOST_AUTO_TEST_CASE(abstract_contract_constructor_args_optional)
 {
 	ASTPointer<SourceUnit> sourceUnit;
@@ -881,6 +942,65 @@ BOOST_AUTO_TEST_CASE(legal_override_indirect)
 	CHECK_SUCCESS(text);
 }
 
+BOOST_AUTO_TEST_CASE(override_chains)
+{
+	ASTPointer<SourceUnit> sourceUnit;
+	char const* text = R"(
+		contract A { function f(uint a) {} function f() {} }
+		contract B is A { function f() {} function g(uint[] storage x) internal {} }
+		contract C is A { function f(uint a) {} function g(uint[] memory x) internal {} }
+		contract D is B, C { function f() {} }
+	)";
+	ETH_TEST_REQUIRE_NO_THROW(sourceUnit = parseAndAnalyse(text), "Parsing and name Resolving failed");
+	std::vector<ASTPointer<ASTNode>> nodes = sourceUnit->nodes();
+	ContractDefinition const* a = dynamic_cast<ContractDefinition const*>(nodes[1].get());
+	ContractDefinition const* b = dynamic_cast<ContractDefinition const*>(nodes[2].get());
+	ContractDefinition const* c = dynamic_cast<ContractDefinition const*>(nodes[3].get());
+	ContractDefinition const* d = dynamic_cast<ContractDefinition const*>(nodes[4].get());
+	BOOST_REQUIRE(a && b && c && d);
+	FunctionDefinition const* af1 = a->definedFunctions()[0];
+	FunctionDefinition const* af0 = a->definedFunctions()[1];
+	FunctionDefinition const* bf0 = b->definedFunctions()[0];
+	FunctionDefinition const* bg = b->definedFunctions()[1];
+	FunctionDefinition const* cf1 = c->definedFunctions()[0];
+	FunctionDefinition const* cg = c->definedFunctions()[1];
+	FunctionDefinition const* df0 = d->definedFunctions()[0];
+	using Chain = ContractDefinition::OverrideChain;
+	BOOST_CHECK(d->overrideChain(*af0) == (Chain{df0, bf0, af0}));
+	BOOST_CHECK(d->overrideChain(*bf0) == (Chain{df0, bf0, af0}));
+	BOOST_CHECK(d->overrideChain(*af1) == (Chain{cf1, af1}));
+	BOOST_CHECK(d->overrideChain(*bg) == Chain{bg});
+	BOOST_CHECK(d->overrideChain(*cg) == Chain{cg});
+	BOOST_CHECK(b->overrideChain(*af0) == (Chain{bf0, af0}));
+	BOOST_CHECK(b->overrideChain(*af1) == Chain{af1});
+}
+
+BOOST_AUTO_TEST_CASE(external_signature_annotations)
+{
+	ASTPointer<SourceUnit> sourceUnit;
+	char const* text = R"(
+		contract A {
+			mapping(address => uint) public balances;
+			event Transfer(address indexed from, uint value);
+			function f(uint8 a, bytes32[] b) {}
+			function g() internal {}
+		}
+	)";
+	ETH_TEST_REQUIRE_NO_THROW(sourceUnit = parseAndAnalyse(text), "Parsing and name Resolving failed");
+	ContractDefinition const* a = dynamic_cast<ContractDefinition const*>(sourceUnit->nodes()[1].get());
+	BOOST_REQUIRE(a);
+	FunctionDefinitionAnnotation const& f = a->definedFunctions()[0]->annotation();
+	BOOST_CHECK_EQUAL(f.externalSignature, "f(uint8,bytes32[])");
+	BOOST_CHECK(f.externalSignatureHash == dev::keccak256("f(uint8,bytes32[])"));
+	BOOST_CHECK(a->definedFunctions()[1]->annotation().externalSignature.empty());
+	BOOST_CHECK_EQUAL(a->stateVariables()[0]->annotation().externalSignature, "balances(address)");
+	EventDefinitionAnnotation const& transfer = a->events()[0]->annotation();
+	BOOST_CHECK_EQUAL(transfer.externalSignature, "Transfer(address,uint256)");
+	BOOST_CHECK(transfer.externalSignatureHash == dev::keccak256("Transfer(address,uint256)"));
+	for (auto const& it: a->interfaceFunctions())
+		BOOST_CHECK(it.first == FixedHash<4>(dev::keccak256(it.second->externalSignature())));
+}
+
 BOOST_AUTO_TEST_CASE(illegal_override_visibility)
 {
 	char const* text = R"(
@@ -1657,6 +1777,46 @@ BOOST_AUTO_TEST_CASE(exp_operator_exponent_too_big)
 	CHECK_ERROR(sourceCode, TypeError, "");
 }
 
+BOOST_AUTO_TEST_CASE(rational_constant_precision_limit)
+{
+	char const* text = R"(
+		contract test {
+			function f() returns(uint d) { return 2 ** 4000000000; }
+		}
+	)";
+	CHECK_ERROR(text, TypeError, "exceeds the precision limit of 4096 bits");
+	text = R"(
+		contract test {
+			function f() returns(uint d) { return 1 << 3000000000; }
+		}
+	)";
+	CHECK_ERROR(text, TypeError, "exceeds the precision limit of 4096 bits");
+	text = R"(
+		contract test {
+			function f() returns(uint d) { return (2 ** 4000 * 2 ** 4000) >> 7800; }
+		}
+	)";
+	CHECK_ERROR(text, TypeError, "exceeds the precision limit of 4096 bits");
+	text = R"(
+		contract test {
+			uint[2 ** 5000] x;
+		}
+	)";
+	CHECK_ERROR(text, TypeError, "exceeds the precision limit of 4096 bits");
+	text = R"(
+		contract test {
+			function f() returns(uint a, uint b, int c, uint d, uint e) {
+				a = (2 ** 4000) >> 3800;
+				b = (1 << 4000) >> 3800;
+				c = (-1) ** 4000000001;
+				d = 1 >> 3000000000;
+				e = 0 ** 4000000000;
+			}
+		}
+	)";
+	BOOST_CHECK(success(text));
+}
+
 BOOST_AUTO_TEST_CASE(enum_member_access)
 {
 	char const* text = R"(
@@ -5032,6 +5192,65 @@ BOOST_AUTO_TEST_CASE(invalid_address_length)
 	CHECK_WARNING(text, "checksum");
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_type_checking)
+{
+	size_t const sourceCount = 6;
+	size_t const contractsPerSource = 8;
+	auto createSources = [&](bool _withErrors)
+	{
+		map<std::string, std::string> sources;
+		sources["base"] = R"(
+			pragma solidity >=0.0;
+			/// @title Base
+			contract Base {
+				struct S { uint a; bytes32 b; }
+				mapping(uint => S) data;
+				event Stored(uint indexed key, uint a);
+				/// @dev Stores @a a under @a key.
+				function store(uint key, uint a) { data[key] = S(a, sha3(a)); Stored(key, a); }
+				function twice(uint x) internal returns (uint) { return 2 * x; }
+			}
+		)";
+		for (size_t k = 0; k < sourceCount; ++k)
+		{
+			std::string source = "pragma solidity >=0.0;\nimport \"base\";\n";
+			for (size_t j = 0; j < contractsPerSource; ++j)
+			{
+				std::string const i = to_string(k * contractsPerSource + j);
+				source +=
+					"/// @title C" + i + "\n"
+					"contract C" + i + " is Base {\n"
+					"	uint[] values;\n"
+					"	/// @notice Adds " + i + ".\n"
+					"	function f(uint a) returns (uint b, bytes32 h) { b = twice(a) + " + i + "; h = sha3(b, this); values.push(b); }\n"
+					"	function g() returns (uint) { var (x, ) = this.f(values.length); return x + data[x].a; }\n";
+				// Each contract creates the next one, with errors the last one creates the first one.
+				if (j + 1 < contractsPerSource)
+					source += "	function h() returns (address) { return new C" + to_string(k * contractsPerSource + j + 1) + "(); }\n";
+				else if (_withErrors)
+					source += "	function h() returns (address) { return new C" + to_string(k * contractsPerSource) + "(); }\n";
+				if (_withErrors)
+					source += "	function e() { uint8 x = " + to_string(256 + j) + "; x; }\n";
+				source += "}\n";
+			}
+			sources["s" + to_string(k)] = source;
+		}
+		return sources;
+	};
+
+	for (bool withErrors: {true, false})
+	{
+		map<std::string, std::string> sources = createSources(withErrors);
+		Json::Value sequential = compileWithThreads(sources, 1);
+		if (withErrors)
+			BOOST_CHECK(sequential["errors"].size() > sourceCount * contractsPerSource);
+		else
+			BOOST_CHECK_EQUAL(sequential["contracts"].size(), 1 + sourceCount * contractsPerSource);
+		for (size_t run = 0; run < 4; ++run)
+			BOOST_CHECK(compileWithThreads(sources, 8) == sequential);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -168,6 +168,16 @@ public:
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
 
+	/// Runs all optimiser steps on the items as part of an assembly.
+	AssemblyItems optimiseAssembly(AssemblyItems const& _input)
+	{
+		Assembly assembly;
+		for (AssemblyItem const& item: _input)
+			assembly.append(item);
+		assembly.optimise(true, true, 200);
+		return assembly.items();
+	}
+
 protected:
 	/// @returns the number of intructions in the given bytecode, not taking the metadata hash
 	/// into account.
@@ -1025,6 +1035,236 @@ BOOST_AUTO_TEST_CASE(cse_optimise_return)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(cse_storage_across_log)
+{
+	// logs do not access storage, so the accesses on both sides of it can be combined
+	AssemblyItems input{
+		u256(0),
+		Instruction::SLOAD,
+		u256(1),
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE,
+		u256(0),
+		u256(0),
+		Instruction::LOG0,
+		u256(0),
+		Instruction::SLOAD,
+		u256(2),
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE
+	};
+	checkCSE(input, {
+		u256(0),
+		Instruction::DUP1,
+		Instruction::SLOAD,
+		Instruction::DUP2,
+		Instruction::DUP1,
+		Instruction::LOG0,
+		u256(3),
+		Instruction::ADD,
+		Instruction::SWAP1,
+		Instruction::SSTORE
+	});
+}
+
+BOOST_AUTO_TEST_CASE(cse_memory_store_before_log)
+{
+	// logs read memory, so the store before the log has to stay
+	AssemblyItems input{
+		u256(5),
+		u256(0),
+		Instruction::MSTORE,
+		u256(0x20),
+		u256(0),
+		Instruction::LOG0,
+		u256(7),
+		u256(0),
+		Instruction::MSTORE
+	};
+	checkCSE(input, {
+		u256(5),
+		u256(0),
+		Instruction::SWAP1,
+		Instruction::DUP2,
+		Instruction::MSTORE,
+		u256(0x20),
+		Instruction::DUP2,
+		Instruction::LOG0,
+		u256(7),
+		Instruction::SWAP1,
+		Instruction::MSTORE
+	});
+}
+
+BOOST_AUTO_TEST_CASE(cse_log2_permuted_arguments)
+{
+	AssemblyItems input{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(0x20),
+		Instruction::CALLDATALOAD,
+		u256(0x40),
+		Instruction::CALLDATALOAD,
+		u256(0x60),
+		Instruction::CALLDATALOAD,
+		Instruction::SWAP2,
+		Instruction::SWAP3,
+		Instruction::SWAP1,
+		Instruction::LOG2
+	};
+	checkCSE(input, {
+		u256(0x20),
+		Instruction::CALLDATALOAD,
+		u256(0x60),
+		Instruction::CALLDATALOAD,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(0x40),
+		Instruction::CALLDATALOAD,
+		Instruction::LOG2
+	});
+}
+
+BOOST_AUTO_TEST_CASE(cse_log3_duplicate_arguments)
+{
+	AssemblyItems input{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		Instruction::DUP1,
+		u256(0x20),
+		Instruction::DUP2,
+		u256(0),
+		Instruction::LOG3
+	};
+	checkCSE(input, {
+		u256(0),
+		Instruction::DUP1,
+		Instruction::CALLDATALOAD,
+		u256(0x20),
+		Instruction::DUP2,
+		Instruction::DUP1,
+		Instruction::DUP3,
+		Instruction::DUP2,
+		Instruction::DUP7,
+		Instruction::LOG3,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::POP
+	});
+}
+
+BOOST_AUTO_TEST_CASE(cse_log4_permuted_duplicate_arguments)
+{
+	AssemblyItems input{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(0x20),
+		Instruction::CALLDATALOAD,
+		Instruction::DUP2,
+		Instruction::DUP2,
+		Instruction::SWAP3,
+		u256(0),
+		u256(0x20),
+		Instruction::SWAP2,
+		Instruction::LOG4
+	};
+	checkCSE(input, {
+		u256(0x20),
+		Instruction::DUP1,
+		Instruction::CALLDATALOAD,
+		u256(0),
+		Instruction::DUP1,
+		Instruction::CALLDATALOAD,
+		Instruction::DUP3,
+		Instruction::DUP1,
+		Instruction::DUP3,
+		Instruction::DUP7,
+		Instruction::DUP6,
+		Instruction::DUP3,
+		Instruction::LOG4,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::POP
+	});
+}
+
+BOOST_AUTO_TEST_CASE(cse_log_arguments_in_place_with_duplicates)
+{
+	// The arguments of the second log are on top of the stack, but in a different order and
+	// the stack contains the same element twice. This used to loop forever.
+	eth::KnownState state = createInitialState(AssemblyItems{
+		Instruction::SLOAD,
+		Instruction::DUP5,
+		Instruction::SWAP1
+	});
+	AssemblyItems input{
+		Instruction::SWAP3,
+		Instruction::SWAP6,
+		u256(0x40),
+		Instruction::SWAP1,
+		Instruction::LOG1,
+		Instruction::SLOAD,
+		Instruction::DUP4,
+		Instruction::LOG4,
+		u256(0x20)
+	};
+	checkCSE(input, {
+		u256(0x40),
+		Instruction::DUP3,
+		Instruction::DUP2,
+		Instruction::DUP10,
+		Instruction::LOG1,
+		Instruction::POP,
+		Instruction::SWAP2,
+		Instruction::SLOAD,
+		Instruction::SWAP1,
+		Instruction::SWAP3,
+		Instruction::SWAP5,
+		Instruction::SWAP4,
+		Instruction::SWAP3,
+		Instruction::LOG4,
+		Instruction::POP,
+		u256(0x20)
+	}, state);
+}
+
+BOOST_AUTO_TEST_CASE(cse_log_arguments_with_duplicates_on_known_stack)
+{
+	// The known stack contains the same element twice and both copies are arguments of the log,
+	// but one of them is still needed afterwards.
+	eth::KnownState state = createInitialState(AssemblyItems{
+		u256(0x60),
+		Instruction::DUP1,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(0)
+	});
+	AssemblyItems input{
+		Instruction::SLOAD,
+		Instruction::MLOAD,
+		u256(0x60),
+		Instruction::LOG2,
+		Instruction::MLOAD
+	};
+	checkCSE(input, {
+		Instruction::SLOAD,
+		Instruction::MLOAD,
+		Instruction::DUP3,
+		Instruction::DUP3,
+		Instruction::DUP3,
+		Instruction::DUP3,
+		Instruction::LOG2,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::MLOAD,
+		Instruction::SWAP1,
+		Instruction::POP
+	}, state);
+}
+
 BOOST_AUTO_TEST_CASE(control_flow_graph_remove_unused)
 {
 	// remove parts of the code that are unused
@@ -1092,6 +1332,184 @@ BOOST_AUTO_TEST_CASE(control_flow_graph_do_not_remove_returned_to)
 	checkCFG(input, {u256(2)});
 }
 
+BOOST_AUTO_TEST_CASE(control_flow_graph_tag_states)
+{
+	// storage knowledge is available at the jump target
+	AssemblyItems input{
+		u256(5),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD
+	};
+	map<BlockId, KnownStatePointer> states = ControlFlowGraph(input).tagStates();
+	BOOST_REQUIRE(states.count(BlockId(1)));
+	checkCSE({u256(0), Instruction::SLOAD}, {u256(5)}, *states.at(BlockId(1)));
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_tag_states_join)
+{
+	// different values on the two paths leading to the tag
+	AssemblyItems input{
+		u256(5),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(6),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD
+	};
+	map<BlockId, KnownStatePointer> states = ControlFlowGraph(input).tagStates();
+	BOOST_REQUIRE(states.count(BlockId(1)));
+	checkCSE({u256(0), Instruction::SLOAD}, {u256(0), Instruction::SLOAD}, *states.at(BlockId(1)));
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_tag_states_unknown_jump)
+{
+	// the jump target is not known, so nothing is known at any tag
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		u256(0),
+		Instruction::SSTORE,
+		u256(5),
+		u256(1),
+		Instruction::SSTORE,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		Instruction::SLOAD
+	};
+	BOOST_CHECK(ControlFlowGraph(input).tagStates().empty());
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_tag_states_loop)
+{
+	// the loop does not modify storage and the code ends in a conditional jump
+	AssemblyItems input{
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI
+	};
+	map<BlockId, KnownStatePointer> states = ControlFlowGraph(input).tagStates();
+	BOOST_REQUIRE(states.count(BlockId(1)));
+	checkCSE({u256(0), Instruction::SLOAD}, {u256(1)}, *states.at(BlockId(1)));
+	checkCFG(input, input);
+	AssemblyItems output = optimiseAssembly(input);
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), output.begin(), output.end());
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_tag_states_loop_modifies_storage)
+{
+	AssemblyItems input{
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(0),
+		Instruction::SSTORE,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP
+	};
+	map<BlockId, KnownStatePointer> states = ControlFlowGraph(input).tagStates();
+	BOOST_REQUIRE(states.count(BlockId(1)));
+	checkCSE({u256(0), Instruction::SLOAD}, {u256(0), Instruction::SLOAD}, *states.at(BlockId(1)));
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_tag_states_different_stack_heights)
+{
+	// the stack is higher on the path that does not jump, so the stack contents are not known
+	AssemblyItems input{
+		u256(5),
+		u256(0),
+		Instruction::SSTORE,
+		u256(7),
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(8),
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD
+	};
+	map<BlockId, KnownStatePointer> states = ControlFlowGraph(input).tagStates();
+	BOOST_REQUIRE(states.count(BlockId(1)));
+	BOOST_CHECK(states.at(BlockId(1))->stackElements().empty());
+	checkCSE({u256(0), Instruction::SLOAD}, {u256(5)}, *states.at(BlockId(1)));
+	checkCSE(
+		{Instruction::DUP1, u256(7), Instruction::EQ},
+		{u256(7), Instruction::DUP2, Instruction::EQ},
+		*states.at(BlockId(1))
+	);
+}
+
+BOOST_AUTO_TEST_CASE(optimiser_known_state_with_duplicates)
+{
+	// The same element is on the stack several times at the start of the blocks.
+	// This used to loop forever.
+	AssemblyItems input{
+		u256(0x40),
+		Instruction::CALLDATALOAD,
+		u256(0x20),
+		Instruction::CALLDATALOAD,
+		u256(0x60),
+		u256(0x40),
+		Instruction::CALLDATALOAD,
+		u256(0x20),
+		Instruction::CALLDATALOAD,
+		u256(0x40),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(Tag, 1),
+		Instruction::SWAP3,
+		Instruction::DUP1,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 2),
+		u256(0x60),
+		Instruction::DUP4,
+		Instruction::SSTORE,
+		Instruction::POP,
+		Instruction::SLOAD,
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		Instruction::SWAP1,
+		Instruction::LOG0,
+		Instruction::DUP1,
+		Instruction::STOP,
+		AssemblyItem(Tag, 4),
+		Instruction::SWAP3,
+		Instruction::POP,
+		u256(0x20),
+		Instruction::LOG0,
+		Instruction::LOG2,
+		Instruction::SLOAD,
+		Instruction::SWAP2
+	};
+	BOOST_CHECK(optimiseAssembly(input).size() <= input.size());
+}
+
 BOOST_AUTO_TEST_CASE(block_deduplicator)
 {
 	AssemblyItems input{
@@ -1234,6 +1652,44 @@ BOOST_AUTO_TEST_CASE(computing_constants)
 	) == optimizedBytecode.cend());
 }
 
+BOOST_AUTO_TEST_CASE(constants_shared_with_runtime)
+{
+	char const* sourceCode = R"(
+		contract c {
+			uint a;
+			uint b;
+			function c() {
+				a = 0x817416927846239487123469187231298734162934871263941234127518276;
+			}
+			function f() returns (uint) {
+				b = 0x817416927846239487123469187231298734162934871263941234127518276;
+				return a;
+			}
+			function g() returns (uint) {
+				a = 0x817416927846239487123469187231298734162934871263941234127518276;
+				return b;
+			}
+		}
+	)";
+	compileBothVersions(sourceCode);
+	compareVersions("f()");
+	compareVersions("g()");
+
+	// The constructor copies the constant from the data section of the runtime code,
+	// so it is only contained once in the creation bytecode.
+	compileAndRunWithOptimizer(sourceCode, 0, "c", true, 1);
+	bytes creationBytecode = m_compiler.object("c").bytecode;
+	bytes complicatedConstant = toBigEndian(u256("0x817416927846239487123469187231298734162934871263941234127518276"));
+	unsigned occurrences = 0;
+	for (auto iter = creationBytecode.cbegin(); iter < creationBytecode.cend(); ++occurrences)
+	{
+		iter = search(iter, creationBytecode.cend(), complicatedConstant.cbegin(), complicatedConstant.cend());
+		if (iter < creationBytecode.cend())
+			++iter;
+	}
+	BOOST_CHECK_EQUAL(2, occurrences);
+}
+
 BOOST_AUTO_TEST_CASE(inconsistency)
 {
 	// This is a test of a bug in the optimizer.
@@ -1330,6 +1786,47 @@ BOOST_AUTO_TEST_CASE(invalid_state_at_control_flow_join)
 	compareVersions("test()");
 }
 
+BOOST_AUTO_TEST_CASE(storage_read_in_loop)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint x = 3;
+			function f(uint n) returns (uint r) {
+				for (uint i = 0; i < n; i++)
+					r += x;
+			}
+		}
+	)";
+	compileBothVersions(sourceCode);
+	compareVersions("f(uint256)", u256(0));
+	compareVersions("f(uint256)", u256(1));
+	compareVersions("f(uint256)", u256(10));
+}
+
+BOOST_AUTO_TEST_CASE(storage_knowledge_across_function_pointer_call)
+{
+	// The call via the function pointer is a jump to an unknown target, so nothing is known
+	// about storage after it returns.
+	char const* sourceCode = R"(
+		contract C {
+			uint x;
+			function() internal returns (uint) g;
+			function a() internal returns (uint) {
+				x = 7;
+				return 1;
+			}
+			function f() returns (uint) {
+				x = 2;
+				g = a;
+				uint r = g();
+				return r + x;
+			}
+		}
+	)";
+	compileBothVersions(sourceCode);
+	compareVersions("f()");
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
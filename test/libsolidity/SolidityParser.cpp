@@ -1479,6 +1479,31 @@ BOOST_AUTO_TEST_CASE(function_type_state_variable)
 	BOOST_CHECK(successParse(text));
 }
 
+BOOST_AUTO_TEST_CASE(identifiers_are_interned)
+{
+	char const* text = R"(
+		contract test {
+			modifier m(uint value, uint aParameterNameLongerThanTheSmallStringBuffer) { _; }
+			function f(uint value, uint aParameterNameLongerThanTheSmallStringBuffer) m(value, 1) {}
+		}
+	)";
+	ErrorList errors;
+	ASTPointer<ContractDefinition> contract = parseText(text, errors);
+	BOOST_REQUIRE(contract);
+	auto modifiers = contract->functionModifiers();
+	auto functions = contract->definedFunctions();
+	BOOST_REQUIRE_EQUAL(modifiers.size(), 1);
+	BOOST_REQUIRE_EQUAL(functions.size(), 1);
+	ASTString const& modifierParameter = modifiers.front()->parameters().front()->name();
+	ASTString const& functionParameter = functions.front()->parameters().front()->name();
+	BOOST_CHECK_EQUAL(functionParameter, "value");
+	BOOST_CHECK_EQUAL(&modifierParameter, &functionParameter);
+	ASTString const& longModifierParameter = modifiers.front()->parameters().back()->name();
+	ASTString const& longFunctionParameter = functions.front()->parameters().back()->name();
+	BOOST_CHECK_EQUAL(longFunctionParameter, "aParameterNameLongerThanTheSmallStringBuffer");
+	BOOST_CHECK_EQUAL(&longModifierParameter, &longFunctionParameter);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
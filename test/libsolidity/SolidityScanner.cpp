@@ -21,7 +21,13 @@
  */
 
 #include <libsolidity/parsing/Scanner.h>
+#include <libdevcore/CommonIO.h>
 #include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
 
 namespace dev
 {
@@ -38,6 +44,89 @@ BOOST_AUTO_TEST_CASE(test_empty)
 	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(all_keywords)
+{
+	for (unsigned i = 0; i < Token::NUM_TOKENS; ++i)
+	{
+		Token::Value token = Token::Value(i);
+		char const* name = Token::toString(token);
+		if (!name || !*name || !all_of(name, name + strlen(name), [](char c) { return 'a' <= c && c <= 'z'; }))
+			continue;
+		Scanner scanner(CharStream(string(name) + " x"));
+		BOOST_CHECK_MESSAGE(scanner.currentToken() == token || token == Token::Hex, name);
+		BOOST_CHECK_EQUAL(get<0>(Token::fromIdentifierOrKeyword(name)), token);
+	}
+	BOOST_CHECK_EQUAL(get<0>(Token::fromIdentifierOrKeyword("contracts")), Token::Identifier);
+	BOOST_CHECK_EQUAL(get<0>(Token::fromIdentifierOrKeyword("Contract")), Token::Identifier);
+	BOOST_CHECK_EQUAL(get<0>(Token::fromIdentifierOrKeyword("_")), Token::Identifier);
+}
+
+BOOST_AUTO_TEST_CASE(sized_elementary_types)
+{
+	BOOST_CHECK(Token::fromIdentifierOrKeyword("uint8") == make_tuple(Token::UIntM, 8, 0));
+	BOOST_CHECK(Token::fromIdentifierOrKeyword("int256") == make_tuple(Token::IntM, 256, 0));
+	BOOST_CHECK(Token::fromIdentifierOrKeyword("bytes32") == make_tuple(Token::BytesM, 32, 0));
+	BOOST_CHECK(Token::fromIdentifierOrKeyword("fixed0x8") == make_tuple(Token::FixedMxN, 0, 8));
+	BOOST_CHECK(Token::fromIdentifierOrKeyword("ufixed128x128") == make_tuple(Token::UFixedMxN, 128, 128));
+	for (char const* name: {"uint7", "uint264", "bytes33", "bytes0", "uint8x", "fixed8x", "fixed8x4", "abc8", "uint99999999999"})
+		BOOST_CHECK_MESSAGE(get<0>(Token::fromIdentifierOrKeyword(name)) == Token::Identifier, name);
+	Scanner scanner(CharStream("uint16 ab1_$"));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::UIntM);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "ab1_$");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(source_view)
+{
+	string buffer = "contract C {}\n// end";
+	CharStream stream(buffer.data(), 13);
+	BOOST_CHECK(stream.source().data() == buffer.data());
+	Scanner scanner(stream);
+	BOOST_CHECK(scanner.source().data() == buffer.data());
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Contract);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::LBrace);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::RBrace);
+	// The rest of the buffer is not part of the source.
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+	BOOST_CHECK_EQUAL(scanner.lineAtPosition(20), "contract C {}");
+}
+
+BOOST_AUTO_TEST_CASE(source_from_file)
+{
+	boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	writeFile(path.string(), string("contract C {\n\tuint x;\n}"));
+	{
+		Scanner scanner(CharStream::fromFile(path.string()));
+		BOOST_CHECK_EQUAL(scanner.source().toString(), "contract C {\n\tuint x;\n}");
+		BOOST_CHECK_EQUAL(scanner.lineAtPosition(15), "\tuint x;");
+		BOOST_CHECK(scanner.translatePositionToLineColumn(15) == make_tuple(1, 2));
+	}
+	boost::filesystem::remove(path);
+	BOOST_CHECK_THROW(CharStream::fromFile(path.string()), FileError);
+}
+
+BOOST_AUTO_TEST_CASE(line_index)
+{
+	CharStream stream("a\nbc\n\ndef");
+	BOOST_CHECK(stream.translatePositionToLineColumn(0) == make_tuple(0, 0));
+	BOOST_CHECK(stream.translatePositionToLineColumn(1) == make_tuple(0, 1));
+	BOOST_CHECK(stream.translatePositionToLineColumn(2) == make_tuple(1, 0));
+	BOOST_CHECK(stream.translatePositionToLineColumn(5) == make_tuple(2, 0));
+	BOOST_CHECK(stream.translatePositionToLineColumn(8) == make_tuple(3, 2));
+	BOOST_CHECK(stream.translatePositionToLineColumn(100) == make_tuple(3, 3));
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "a");
+	// A position pointing to a newline belongs to the line before.
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(1), "a");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(3), "bc");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(5), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(7), "def");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(100), "def");
+	BOOST_CHECK_EQUAL(CharStream("").lineAtPosition(0), "");
+	BOOST_CHECK(CharStream("").translatePositionToLineColumn(3) == make_tuple(0, 0));
+}
+
 BOOST_AUTO_TEST_CASE(smoke_test)
 {
 	Scanner scanner(CharStream("function break;765  \t  \"string1\",'string2'\nidentifier1"));
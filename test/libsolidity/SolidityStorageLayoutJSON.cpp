@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Unit tests for the storage layout output and the storage packing option.
+ */
+
+#include "../TestHelper.h"
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <json/json.h>
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+class StorageLayoutChecker
+{
+public:
+	/// Checks the positions of the state variables of the last contract in @a _code against
+	/// @a _expectation, which lists "contract.label slot offset" for each variable in storage order.
+	void checkLayout(std::string const& _code, bool _packed, std::vector<std::string> const& _expectation)
+	{
+		CompilerStack compilerStack;
+		compilerStack.setPackStorage(_packed);
+		ETH_TEST_REQUIRE_NO_THROW(compilerStack.parse("pragma solidity >=0.0;\n" + _code), "Parsing contract failed");
+
+		Json::Value storage = compilerStack.storageLayout()["storage"];
+		std::vector<std::string> layout;
+		for (auto const& entry: storage)
+			layout.push_back(
+				entry["contract"].asString().substr(1) + "." + entry["label"].asString() + " " +
+				entry["slot"].asString() + " " + entry["offset"].asString()
+			);
+		BOOST_CHECK_EQUAL_COLLECTIONS(layout.begin(), layout.end(), _expectation.begin(), _expectation.end());
+	}
+};
+
+BOOST_FIXTURE_TEST_SUITE(SolidityStorageLayoutJSON, StorageLayoutChecker)
+
+BOOST_AUTO_TEST_CASE(default_layout)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint8 a;
+			uint b;
+			uint8 c;
+			uint constant d = 2;
+			mapping(uint => uint) e;
+			bool f;
+		}
+	)";
+	checkLayout(sourceCode, false, {"C.a 0 0", "C.b 1 0", "C.c 2 0", "C.e 3 0", "C.f 4 0"});
+}
+
+BOOST_AUTO_TEST_CASE(entry_details)
+{
+	CompilerStack compilerStack;
+	ETH_TEST_REQUIRE_NO_THROW(compilerStack.parse("contract C { uint16 a; mapping(address => uint) b; }"), "Parsing contract failed");
+	Json::Value storage = compilerStack.storageLayout()["storage"];
+	BOOST_REQUIRE_EQUAL(storage.size(), 2);
+	BOOST_CHECK_EQUAL(storage[0]["contract"].asString(), ":C");
+	BOOST_CHECK_EQUAL(storage[0]["type"].asString(), "t_uint16");
+	BOOST_CHECK_EQUAL(storage[1]["label"].asString(), "b");
+	BOOST_CHECK_EQUAL(storage[1]["slot"].asString(), "1");
+	BOOST_CHECK_EQUAL(storage[1]["type"].asString(), "t_mapping$_t_address_$_t_uint256_$");
+	BOOST_CHECK(storage[0]["astId"].asUInt() != storage[1]["astId"].asUInt());
+}
+
+BOOST_AUTO_TEST_CASE(types)
+{
+	char const* sourceCode = R"(
+		contract C {
+			struct S { uint8 a; uint b; S[] c; }
+			mapping(address => S) m;
+			uint16[3] x;
+			string s;
+		}
+	)";
+	CompilerStack compilerStack;
+	ETH_TEST_REQUIRE_NO_THROW(compilerStack.parse(sourceCode), "Parsing contract failed");
+	Json::Value layout = compilerStack.storageLayout();
+	Json::Value const& types = layout["types"];
+
+	std::string mapping = layout["storage"][0]["type"].asString();
+	BOOST_CHECK_EQUAL(types[mapping]["encoding"].asString(), "mapping");
+	BOOST_CHECK_EQUAL(types[mapping]["numberOfBytes"].asString(), "32");
+	BOOST_CHECK_EQUAL(types[mapping]["key"].asString(), "t_address");
+	BOOST_CHECK_EQUAL(types["t_address"]["numberOfBytes"].asString(), "20");
+
+	Json::Value const& structType = types[types[mapping]["value"].asString()];
+	BOOST_CHECK_EQUAL(structType["label"].asString(), "struct C.S");
+	BOOST_CHECK_EQUAL(structType["numberOfBytes"].asString(), "96");
+	Json::Value const& members = structType["members"];
+	BOOST_REQUIRE_EQUAL(members.size(), 3);
+	BOOST_CHECK_EQUAL(members[1]["label"].asString(), "b");
+	BOOST_CHECK_EQUAL(members[1]["slot"].asString(), "1");
+	BOOST_CHECK_EQUAL(members[2]["slot"].asString(), "2");
+	Json::Value const& recursiveArray = types[members[2]["type"].asString()];
+	BOOST_CHECK_EQUAL(recursiveArray["encoding"].asString(), "dynamic_array");
+	BOOST_CHECK_EQUAL(recursiveArray["base"].asString(), types[mapping]["value"].asString());
+
+	Json::Value const& staticArray = types[layout["storage"][1]["type"].asString()];
+	BOOST_CHECK_EQUAL(staticArray["encoding"].asString(), "inplace");
+	BOOST_CHECK_EQUAL(staticArray["base"].asString(), "t_uint16");
+	BOOST_CHECK_EQUAL(staticArray["numberOfBytes"].asString(), "32");
+	BOOST_CHECK_EQUAL(types[layout["storage"][2]["type"].asString()]["encoding"].asString(), "bytes");
+}
+
+BOOST_AUTO_TEST_CASE(packed_layout)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint8 a;
+			uint b;
+			uint8 c;
+			uint16[2] d;
+			uint128 e;
+			bytes31 f;
+		}
+	)";
+	checkLayout(sourceCode, true, {
+		"C.f 0 0", "C.a 0 31",
+		"C.e 1 0", "C.c 1 16",
+		"C.b 2 0",
+		"C.d 3 0"
+	});
+}
+
+BOOST_AUTO_TEST_CASE(packed_layout_keeps_base_positions)
+{
+	char const* sourceCode = R"(
+		contract A {
+			uint8 a;
+			uint b;
+		}
+		contract B is A {
+			uint8 c;
+			uint240 d;
+			address e;
+		}
+	)";
+	checkLayout(sourceCode, true, {
+		"A.a 0 0", "B.d 0 1", "B.c 0 31",
+		"A.b 1 0",
+		"B.e 2 0"
+	});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -21,9 +21,11 @@
  */
 
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
 #include <libdevcore/SHA3.h>
 #include <boost/test/unit_test.hpp>
+#include "TypeProviderFixture.h"
 
 using namespace std;
 
@@ -34,7 +36,7 @@ namespace solidity
 namespace test
 {
 
-BOOST_AUTO_TEST_SUITE(SolidityTypes)
+BOOST_FIXTURE_TEST_SUITE(SolidityTypes, TypeProviderFixture)
 
 BOOST_AUTO_TEST_CASE(storage_layout_simple)
 {
@@ -153,6 +155,71 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	BOOST_CHECK(Type::fromElementaryTypeName("uint") == Type::fromElementaryTypeName("uint256"));
+	BOOST_CHECK(Type::fromElementaryTypeName("uint") == TypeProvider::uint256());
+	BOOST_CHECK(Type::fromElementaryTypeName("int8") == TypeProvider::integer(8, IntegerType::Modifier::Signed));
+	BOOST_CHECK(Type::fromElementaryTypeName("address") == TypeProvider::address());
+	BOOST_CHECK(Type::fromElementaryTypeName("byte") == Type::fromElementaryTypeName("bytes1"));
+	BOOST_CHECK(Type::fromElementaryTypeName("bool") == TypeProvider::boolean());
+	BOOST_CHECK(Type::fromElementaryTypeName("ufixed") == Type::fromElementaryTypeName("ufixed128x128"));
+	BOOST_CHECK(Type::fromElementaryTypeName("int8") != Type::fromElementaryTypeName("uint8"));
+	BOOST_CHECK(RationalNumberType(rational(7)).mobileType() == TypeProvider::integer(8));
+	BOOST_CHECK(&TypeProvider::address()->members(nullptr) == &Type::fromElementaryTypeName("address")->members(nullptr));
+
+	// Providers are not shared between compilations.
+	TypePointer uint = TypeProvider::uint256();
+	TypeProvider* provider = TypeProvider::current();
+	TypeProvider otherProvider;
+	{
+		TypeProvider::Scope otherScope(otherProvider);
+		BOOST_CHECK(TypeProvider::current() == &otherProvider);
+		BOOST_CHECK(TypeProvider::uint256() != uint);
+		BOOST_CHECK(*TypeProvider::uint256() == *uint);
+	}
+	BOOST_CHECK(TypeProvider::current() == provider);
+	BOOST_CHECK(TypeProvider::uint256() == uint);
+}
+
+BOOST_AUTO_TEST_CASE(interned_declaration_types)
+{
+	ContractDefinition c(SourceLocation{}, make_shared<string>("C"), {}, {}, {}, false);
+	BOOST_CHECK(c.type() == c.type());
+	BOOST_CHECK(c.type() == TypeProvider::typeType(c));
+	BOOST_CHECK(TypeProvider::contract(c) == TypeProvider::contract(c));
+	BOOST_CHECK(TypeProvider::contract(c) != TypeProvider::contract(c, true));
+	ContractDefinition d(SourceLocation{}, make_shared<string>("C"), {}, {}, {}, false);
+	BOOST_CHECK(c.type() != d.type());
+
+	StructDefinition s({}, make_shared<string>("S"), {});
+	BOOST_CHECK(s.type() == s.type());
+	BOOST_CHECK(TypeProvider::structType(s) == TypeProvider::structType(s));
+	EnumDefinition e({}, make_shared<string>("E"), {});
+	BOOST_CHECK(e.type() == e.type());
+	BOOST_CHECK(TypeProvider::enumType(e) == TypeProvider::enumType(e));
+
+	auto emptyParams = make_shared<ParameterList>(SourceLocation(), vector<ASTPointer<VariableDeclaration>>());
+	FunctionDefinition f(
+		SourceLocation{}, make_shared<string>("f"), Declaration::Visibility::Public, false,
+		nullptr, emptyParams, false, {}, emptyParams, false, nullptr
+	);
+	BOOST_CHECK(f.type() == f.type());
+	BOOST_CHECK(f.functionType(true) == f.type());
+	BOOST_CHECK(f.functionType(false) != f.type());
+	BOOST_CHECK(f.functionType(false) == f.functionType(false));
+
+	// Function types with unresolved parameter types are not shared.
+	auto unresolvedParams = make_shared<ParameterList>(SourceLocation(), vector<ASTPointer<VariableDeclaration>>{
+		make_shared<VariableDeclaration>(SourceLocation(), nullptr, make_shared<string>("x"), nullptr, Declaration::Visibility::Default)
+	});
+	FunctionDefinition g(
+		SourceLocation{}, make_shared<string>("g"), Declaration::Visibility::Public, false,
+		nullptr, unresolvedParams, false, {}, emptyParams, false, nullptr
+	);
+	BOOST_CHECK(g.type() != g.type());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,43 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Fixture for tests that create types without a compiler stack.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/TypeProvider.h>
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+/// Makes a fresh type provider current for the duration of a test case.
+class TypeProviderFixture
+{
+private:
+	TypeProvider m_provider;
+	TypeProvider::Scope m_scope{m_provider};
+};
+
+}
+}
+}